@@ -508,8 +508,11 @@ def OpenItemAmountWindow ():
 	Window.ShowModal (MODAL_SHADOW_GRAY)
 	return
 
-def UpdateSlot (pc, slot):
-	"""Updates a specific slot."""
+def UpdateSlot (pc, slot, SlotItems=None):
+	"""Updates a specific slot.
+
+	SlotItems is an optional GemRB.GetSlotItems snapshot, so refreshing
+	all the slots doesn't need a query per slot."""
 
 	Window = GUIINV.InventoryWindow
 	SlotType = GemRB.GetSlotType (slot+1, pc)
@@ -527,7 +530,10 @@ def UpdateSlot (pc, slot):
 		itemname = ""
 
 	Button = Window.GetControl (ControlID)
-	slot_item = GemRB.GetSlotItem (pc, slot+1)
+	if SlotItems is None:
+		slot_item = GemRB.GetSlotItem (pc, slot+1)
+	else:
+		slot_item = SlotItems.get (slot+1)
 
 	Button.SetEvent (IE_GUI_BUTTON_ON_DRAG_DROP, OnDragItem)
 	Button.SetFlags (IE_GUI_BUTTON_NO_IMAGE, OP_NAND)
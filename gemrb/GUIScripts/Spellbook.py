@@ -45,10 +45,9 @@ def itemgetter(*items):
 def GetUsableMemorizedSpells(actor, BookType):
 	memorizedSpells = []
 	spellResRefs = []
-	for level in range (20): # Saradas NPC teaches you a level 14 special ...
-		spellCount = GemRB.GetMemorizedSpellsCount (actor, BookType, level, False)
-		for i in range (spellCount):
-			Spell0 = GemRB.GetMemorizedSpell (actor, BookType, level, i)
+	Book = GemRB.GetSpellbook (actor, BookType)
+	for level in Book[:20]: # Saradas NPC teaches you a level 14 special ...
+		for Spell0 in level["Memorized"]:
 			if not Spell0["Flags"]:
 				# depleted, so skip
 				continue
@@ -82,14 +81,13 @@ def GetUsableMemorizedSpells(actor, BookType):
 def GetKnownSpells(actor, BookType):
 	knownSpells = []
 	spellResRefs = []
-	for level in range (9):
-		spellCount = GemRB.GetKnownSpellsCount (actor, BookType, level)
-		for i in range (spellCount):
-			Spell0 = GemRB.GetKnownSpell (actor, BookType, level, i)
-			if Spell0["SpellResRef"] in spellResRefs:
+	Book = GemRB.GetSpellbook (actor, BookType)
+	for level in Book[:9]:
+		for SpellResRef in level["Known"]:
+			if SpellResRef in spellResRefs:
 				continue
-			spellResRefs.append (Spell0["SpellResRef"])
-			Spell = GemRB.GetSpell(Spell0["SpellResRef"])
+			spellResRefs.append (SpellResRef)
+			Spell = GemRB.GetSpell(SpellResRef)
 			Spell['BookType'] = BookType # just another sorting key
 			Spell['MemoCount'] = 0
 			Spell['SpellIndex'] = 1000 * 1<<BookType # this gets assigned properly later
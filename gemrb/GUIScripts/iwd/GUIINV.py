@@ -203,8 +203,9 @@ def UpdateInventoryWindow ():
 	#populate inventory slot controls
 	SlotCount = GemRB.GetSlotType (-1)["Count"]
 
+	SlotItems = GemRB.GetSlotItems (pc)
 	for i in range (SlotCount):
-		InventoryCommon.UpdateSlot (pc, i)
+		InventoryCommon.UpdateSlot (pc, i, SlotItems)
 	return
 
 def RefreshInventoryWindow ():
@@ -168,6 +168,8 @@ def UpdateRecordsWindow ():
 		return
 
 	pc = GemRB.GameGetSelectedPCSingle ()
+	Stats = GemRB.GetPlayerStats (pc)
+	BaseStats = GemRB.GetPlayerStats (pc, 1)
 	
 	# Setting up the character information
 	GetCharacterHeader (pc)
@@ -198,39 +200,39 @@ def UpdateRecordsWindow ():
 
 	# armorclass
 	Label = Window.GetControl (0x1000000b)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_ARMORCLASS)))
+	Label.SetText (str (Stats[IE_ARMORCLASS]))
 	Label.SetTooltip (4197)
 
 	# hp now
 	Label = Window.GetControl (0x1000000c)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_HITPOINTS)))
+	Label.SetText (str (Stats[IE_HITPOINTS]))
 	Label.SetTooltip (4198)
 
 	# hp max
 	Label = Window.GetControl (0x1000000d)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_MAXHITPOINTS)))
+	Label.SetText (str (Stats[IE_MAXHITPOINTS]))
 	Label.SetTooltip (4199)
 
 	# stats
 
-	sstr = GemRB.GetPlayerStat (pc, IE_STR)
-	bstr = GemRB.GetPlayerStat (pc, IE_STR,1)
-	sstrx = GemRB.GetPlayerStat (pc, IE_STREXTRA)
-	bstrx = GemRB.GetPlayerStat (pc, IE_STREXTRA,1)
+	sstr = Stats[IE_STR]
+	bstr = BaseStats[IE_STR]
+	sstrx = Stats[IE_STREXTRA]
+	bstrx = BaseStats[IE_STREXTRA]
 	if (sstrx > 0) and (sstr==18):
 		sstr = "%d/%02d" %(sstr, sstrx % 100)
 	if (bstrx > 0) and (bstr==18):
 		bstr = "%d/%02d" %(bstr, bstrx % 100)
-	sint = GemRB.GetPlayerStat (pc, IE_INT)
-	bint = GemRB.GetPlayerStat (pc, IE_INT,1)
-	swis = GemRB.GetPlayerStat (pc, IE_WIS)
-	bwis = GemRB.GetPlayerStat (pc, IE_WIS,1)
-	sdex = GemRB.GetPlayerStat (pc, IE_DEX)
-	bdex = GemRB.GetPlayerStat (pc, IE_DEX,1)
-	scon = GemRB.GetPlayerStat (pc, IE_CON)
-	bcon = GemRB.GetPlayerStat (pc, IE_CON,1)
-	schr = GemRB.GetPlayerStat (pc, IE_CHR)
-	bchr = GemRB.GetPlayerStat (pc, IE_CHR,1)
+	sint = Stats[IE_INT]
+	bint = BaseStats[IE_INT]
+	swis = Stats[IE_WIS]
+	bwis = BaseStats[IE_WIS]
+	sdex = Stats[IE_DEX]
+	bdex = BaseStats[IE_DEX]
+	scon = Stats[IE_CON]
+	bcon = BaseStats[IE_CON]
+	schr = Stats[IE_CHR]
+	bchr = BaseStats[IE_CHR]
 
 	stats = (sstr, sint, swis, sdex, scon, schr)
 	basestats = (bstr, bint, bwis, bdex, bcon, bchr)
@@ -244,9 +246,9 @@ def UpdateRecordsWindow ():
 
 	# race
 	# HACK: for some strange reason, Morte's race is 1 (Human), instead of 45 (Morte)
-	print "species: %d  race: %d" %(GemRB.GetPlayerStat (pc, IE_SPECIES), GemRB.GetPlayerStat (pc, IE_RACE))
+	print "species: %d  race: %d" %(Stats[IE_SPECIES], Stats[IE_RACE])
 	#be careful, some saves got this field corrupted
-	race = GemRB.GetPlayerStat (pc, IE_SPECIES) - 1
+	race = Stats[IE_SPECIES] - 1
 
 	text = CommonTables.Races.GetValue (race, 0)
 	
@@ -256,7 +258,7 @@ def UpdateRecordsWindow ():
 
 	# sex
 	GenderTable = GemRB.LoadTable ("GENDERS")
-	text = GenderTable.GetValue (GemRB.GetPlayerStat (pc, IE_SEX) - 1, GTV_STR)
+	text = GenderTable.GetValue (Stats[IE_SEX] - 1, GTV_STR)
 	
 	Label = Window.GetControl (0x10000015)
 	Label.SetText (text)
@@ -269,7 +271,7 @@ def UpdateRecordsWindow ():
 	Label.SetText (text)
 
 	# alignment
-	align = GemRB.GetPlayerStat (pc, IE_ALIGNMENT)
+	align = Stats[IE_ALIGNMENT]
 	ss = GemRB.LoadSymbol ("ALIGN")
 	sym = ss.GetValue (align)
 
@@ -285,7 +287,7 @@ def UpdateRecordsWindow ():
 
 
 	# faction
-	faction = GemRB.GetPlayerStat (pc, IE_FACTION)
+	faction = Stats[IE_FACTION]
 	FactionTable = GemRB.LoadTable ("FACTIONS")
 	faction_help = FactionTable.GetValue (faction, 0, GTV_REF)
 	frame = FactionTable.GetValue (faction, 1)
@@ -501,7 +503,8 @@ def GetStatOverview (pc):
 	woff = "[/color]"
 	str_None = GemRB.GetString (41275)
 	
-	GS = lambda s, pc=pc: GemRB.GetPlayerStat (pc, s)
+	Stats = GemRB.GetPlayerStats (pc)
+	GS = lambda s: Stats[s]
 
 	stats = []
 
@@ -35,6 +35,8 @@ public:
 	//decompressing a .sav file similar to CBF
 	virtual int DecompressSaveGame(DataStream *compressed) = 0;
 	virtual int AddToSaveGame(DataStream *str, DataStream *uncompressed) = 0;
+	//checks every member of a .sav file against its file in the cache
+	virtual int VerifySaveGame(DataStream *compressed) = 0;
 };
 
 }
@@ -0,0 +1,201 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2020 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "AreaPrefetcher.h"
+
+#include "Game.h"
+#include "GameData.h"
+#include "Interface.h"
+#include "Map.h"
+#include "TileMap.h"
+#include "WorldMap.h"
+#include "Scriptable/InfoPoint.h"
+#include "System/MemoryStream.h"
+
+namespace GemRB {
+
+//bytes read per update, a tileset takes a few seconds of idling this way
+#define PREFETCH_CHUNK (128*1024)
+//neighbouring areas considered at once
+#define MAX_PREFETCH_AREAS 3
+
+//header offsets of the resref fields we need
+#define ARE_WED_OFFSET 8
+#define WED_OVERLAY_OFFSET 16
+#define WED_TILESET_OFFSET 4
+
+AreaPrefetcher::AreaPrefetcher()
+{
+	plannedArea[0] = 0;
+	source = NULL;
+	buffer = NULL;
+	size = pos = 0;
+}
+
+AreaPrefetcher::~AreaPrefetcher()
+{
+	AbortJob();
+}
+
+void AreaPrefetcher::Reset()
+{
+	AbortJob();
+	jobs.clear();
+	plannedArea[0] = 0;
+}
+
+void AreaPrefetcher::AddJob(const ieResRef ResRef, SClass_ID type)
+{
+	Job job;
+	CopyResRef(job.ResRef, ResRef);
+	job.type = type;
+	jobs.push_back(job);
+}
+
+void AreaPrefetcher::PlanArea(Map *area)
+{
+	Reset();
+	CopyResRef(plannedArea, area->GetScriptName());
+
+	std::vector<const char *> areas;
+	Game *game = core->GetGame();
+	TileMap *tm = area->GetTileMap();
+	for (size_t i = 0; i < tm->GetInfoPointCount() && areas.size() < MAX_PREFETCH_AREAS; i++) {
+		const InfoPoint *ip = tm->GetInfoPoint((unsigned int) i);
+		if (ip->Type != ST_TRAVEL || !ip->Destination[0]) {
+			continue;
+		}
+		areas.push_back(ip->Destination);
+	}
+
+	WorldMap *worldmap = core->GetWorldMap();
+	unsigned int index;
+	WMPAreaEntry *entry = worldmap ? worldmap->GetArea(plannedArea, index) : NULL;
+	for (int dir = 0; entry && dir < 4; dir++) {
+		for (unsigned int i = 0; i < entry->AreaLinksCount[dir] && areas.size() < MAX_PREFETCH_AREAS; i++) {
+			const WMPAreaLink *link = worldmap->GetLink(entry->AreaLinksIndex[dir] + i);
+			areas.push_back(worldmap->GetEntry(link->AreaIndex)->AreaResRef);
+		}
+	}
+
+	for (size_t i = 0; i < areas.size(); i++) {
+		// loaded areas need no help, the others start with finding their WED
+		if (stricmp(areas[i], plannedArea) && game->FindMap(areas[i]) < 0) {
+			AddJob(areas[i], IE_ARE_CLASS_ID);
+		}
+	}
+}
+
+bool AreaPrefetcher::StartJob(const Job &job)
+{
+	if (gamedata->IsPrefetched(job.ResRef, job.type)) {
+		return false;
+	}
+	source = gamedata->GetResource(job.ResRef, job.type, true);
+	if (!source) {
+		return false;
+	}
+	active = job;
+	size = source->Size();
+	pos = 0;
+	buffer = (char *) malloc(size);
+	return true;
+}
+
+void AreaPrefetcher::AbortJob()
+{
+	delete source;
+	source = NULL;
+	free(buffer);
+	buffer = NULL;
+	size = pos = 0;
+}
+
+void AreaPrefetcher::FinishJob()
+{
+	MemoryStream *stream = new MemoryStream(source->originalfile, buffer, size);
+	buffer = NULL;
+	AbortJob();
+
+	ieResRef next;
+	memset(next, 0, sizeof(next));
+	switch (active.type) {
+	case IE_ARE_CLASS_ID:
+		// area files are small, but may change while we wait (they are
+		// saved to the cache), so only the WED reference is used
+		stream->Seek(ARE_WED_OFFSET, GEM_STREAM_START);
+		stream->ReadResRef(next);
+		delete stream;
+		if (next[0]) {
+			AddJob(next, IE_WED_CLASS_ID);
+		}
+		return;
+	case IE_WED_CLASS_ID:
+		// the first overlay holds the main tileset
+		ieDword overlays;
+		stream->Seek(WED_OVERLAY_OFFSET, GEM_STREAM_START);
+		stream->ReadDword(&overlays);
+		stream->Seek(overlays + WED_TILESET_OFFSET, GEM_STREAM_START);
+		stream->ReadResRef(next);
+		stream->Rewind();
+		break;
+	default:
+		break;
+	}
+
+	gamedata->AddPrefetched(active.ResRef, active.type, stream);
+	if (next[0]) {
+		AddJob(next, IE_TIS_CLASS_ID);
+	}
+}
+
+void AreaPrefetcher::Update(Map *area)
+{
+	if (!area) {
+		return;
+	}
+	if (strnicmp(plannedArea, area->GetScriptName(), 8)) {
+		PlanArea(area);
+	}
+
+	while (!source) {
+		if (jobs.empty()) {
+			return;
+		}
+		Job job = jobs.front();
+		jobs.erase(jobs.begin());
+		StartJob(job);
+	}
+
+	unsigned long chunk = size - pos;
+	if (chunk > PREFETCH_CHUNK) {
+		chunk = PREFETCH_CHUNK;
+	}
+	if (source->Read(buffer + pos, chunk) != (int) chunk) {
+		AbortJob();
+		return;
+	}
+	pos += chunk;
+	if (pos == size) {
+		FinishJob();
+	}
+}
+
+}
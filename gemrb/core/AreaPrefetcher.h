@@ -0,0 +1,78 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2020 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef AREAPREFETCHER_H
+#define AREAPREFETCHER_H
+
+#include "SClassID.h"
+#include "exports.h"
+#include "ie_types.h"
+
+#include <vector>
+
+namespace GemRB {
+
+class DataStream;
+class Map;
+
+/**
+ * @class AreaPrefetcher
+ * Reads the tile data of the areas the party is likely to visit next
+ * (travel regions and worldmap links of the current area) into memory.
+ * Only a small chunk is read per call, so it can run while the party is
+ * idle without stalling the game. The finished resources are handed to
+ * gamedata, where Game::LoadMap will pick them up.
+ */
+
+class GEM_EXPORT AreaPrefetcher {
+public:
+	AreaPrefetcher();
+	~AreaPrefetcher();
+
+	/** Does a bounded amount of read-ahead for the neighbours of area. */
+	void Update(Map *area);
+	/** Drops all pending work. */
+	void Reset();
+private:
+	struct Job {
+		ieResRef ResRef;
+		SClass_ID type;
+	};
+
+	void PlanArea(Map *area);
+	void AddJob(const ieResRef ResRef, SClass_ID type);
+	bool StartJob(const Job &job);
+	void FinishJob();
+	void AbortJob();
+
+	ieResRef plannedArea;
+	std::vector<Job> jobs;
+
+	// the resource being read in
+	Job active;
+	DataStream *source;
+	char *buffer;
+	unsigned long size;
+	unsigned long pos;
+};
+
+}
+
+#endif
@@ -393,11 +393,14 @@ void CharAnimations::SetupColors(PaletteType type)
 			return;
 		}
 		*/
+		// the palette may be shared with other actors, so never change it in place
+		Palette* look = new Palette(pal->col, pal->alpha);
 		for (int i = 0; i < colorcount; i++) {
 			core->GetPalette( Colors[i]&255, size,
-				&palette[PAL_MAIN]->col[dest] );
+				&look->col[dest] );
 			dest +=size;
 		}
+		UpdatePalette(type, look);
 
 		if (needmod) {
 			if (!modifiedPalette[PAL_MAIN])
@@ -444,7 +447,10 @@ void CharAnimations::SetupColors(PaletteType type)
 		return;
 	}
 
-	pal->SetupPaperdollColours(Colors, type);
+	// the palette may be shared with other actors, so never change it in place
+	Palette* look = new Palette(pal->col, pal->alpha);
+	look->SetupPaperdollColours(Colors, type);
+	UpdatePalette(type, look);
 	if (lockPalette) {
 		return;
 	}
@@ -475,6 +481,24 @@ void CharAnimations::SetupColors(PaletteType type)
 
 }
 
+// copy on write: only replace the part palette if the colours changed, and
+// then with the instance shared by every actor that looks the same
+void CharAnimations::UpdatePalette(PaletteType type, Palette* look)
+{
+	if (*look == *palette[type]) {
+		look->release();
+		return;
+	}
+	if (palette[type]->named) {
+		// owned by the palette cache, so just update it like before
+		memcpy(palette[type]->col, look->col, sizeof(look->col));
+		look->release();
+		return;
+	}
+	gamedata->FreePalette(palette[type], 0);
+	palette[type] = gamedata->InternPalette(look);
+}
+
 Palette* CharAnimations::GetPartPalette(int part)
 {
 	int actorPartCount = GetActorPartCount();
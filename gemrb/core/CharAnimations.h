@@ -274,6 +274,7 @@ private:
 		char* ResRef, unsigned char& Cycle, EquipResRefData* equip);
 	unsigned char MaybeOverrideStance(unsigned char stance) const;
 	void MaybeUpdateMainPalette(Animation**);
+	void UpdatePalette(PaletteType type, Palette* look);
 };
 
 }
@@ -333,18 +333,18 @@ bool DialogHandler::DialogChoose(unsigned int choose)
 			}
 
 			// do not interrupt during dialog actions (needed for aerie.d polymorph block)
-			target->AddAction( GenerateAction( "SetInterrupt(FALSE)" ) );
+			target->AddAction( GenerateCachedAction( "SetInterrupt(FALSE)" ) );
 			// delay all other actions until the next cycle (needed for the machine of Lum the Mad (gorlum2.dlg))
 			// FIXME: figure out if pst needs something similar (action missing)
 			//        (not conditional on GenerateAction to prevent console spam)
 			if (!core->HasFeature(GF_AREA_OVERRIDE) && !(tr->Flags & IE_DLG_IMMEDIATE)) {
-				target->AddAction(GenerateAction("BreakInstants()"));
+				target->AddAction(GenerateCachedAction("BreakInstants()"));
 			}
 			for (unsigned int i = 0; i < tr->actions.size(); i++) {
 				if (i == tr->actions.size() - 1) tr->actions[i]->flags |= ACF_REALLOW_SCRIPTS;
 				target->AddAction(tr->actions[i]);
 			}
-			target->AddAction( GenerateAction( "SetInterrupt(TRUE)" ) );
+			target->AddAction( GenerateCachedAction( "SetInterrupt(TRUE)" ) );
 		}
 
 		if (tr->Flags & IE_DLG_TR_FINAL) {
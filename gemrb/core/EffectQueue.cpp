@@ -36,6 +36,7 @@
 #include "TableMgr.h"
 #include "System/StringBuffer.h"
 
+#include <algorithm>
 #include <cstdio>
 #include "GameData.h"
 
@@ -349,6 +350,13 @@ EffectQueue::EffectQueue()
 	Owner = NULL;
 }
 
+// orders effects by opcode, allowing lookups by a bare opcode too
+struct OpcodeOrder {
+	bool operator() (const Effect *fx, ieDword opcode) const { return fx->Opcode < opcode; }
+	bool operator() (ieDword opcode, const Effect *fx) const { return opcode < fx->Opcode; }
+	bool operator() (const Effect *fx1, const Effect *fx2) const { return fx1->Opcode < fx2->Opcode; }
+};
+
 EffectQueue::~EffectQueue()
 {
 	std::list< Effect* >::iterator f;
@@ -493,11 +501,34 @@ void EffectQueue::AddEffect(const Effect* fx, bool insert)
 	memcpy( new_fx, fx, sizeof( Effect ) );
 	if( insert) {
 		effects.insert( effects.begin(), new_fx );
+		opcodeIndex.insert(std::lower_bound(opcodeIndex.begin(), opcodeIndex.end(), new_fx->Opcode, OpcodeOrder()), new_fx);
 	} else {
 		effects.push_back( new_fx );
+		opcodeIndex.insert(std::upper_bound(opcodeIndex.begin(), opcodeIndex.end(), new_fx->Opcode, OpcodeOrder()), new_fx);
+	}
+}
+
+EffectQueue::OpcodeRange EffectQueue::GetOpcodeRange(ieDword opcode) const
+{
+	return std::equal_range(opcodeIndex.begin(), opcodeIndex.end(), opcode, OpcodeOrder());
+}
+
+void EffectQueue::UnindexEffect(const Effect* fx)
+{
+	OpcodeRange range = GetOpcodeRange(fx->Opcode);
+	OpcodeIterator f = std::find(range.first, range.second, fx);
+	if (f != range.second) {
+		opcodeIndex.erase(opcodeIndex.begin() + (f - opcodeIndex.begin()));
 	}
 }
 
+//some effects turn themselves into another opcode when applied
+void EffectQueue::RebuildIndex() const
+{
+	opcodeIndex.assign(effects.begin(), effects.end());
+	std::stable_sort(opcodeIndex.begin(), opcodeIndex.end(), OpcodeOrder());
+}
+
 //This method can remove an effect described by a pointer to it, or
 //an exact matching effect
 bool EffectQueue::RemoveEffect(const Effect* fx)
@@ -508,6 +539,7 @@ bool EffectQueue::RemoveEffect(const Effect* fx)
 		Effect* fx2 = *f;
 
 		if( (fx==fx2) || !memcmp( fx, fx2, invariant_size)) {
+			UnindexEffect(fx2);
 			delete fx2;
 			effects.erase( f );
 			return true;
@@ -532,10 +564,17 @@ void EffectQueue::ApplyAllEffects(Actor* target) const
 	}
 }
 
+static bool IsJustExpired(const Effect *fx)
+{
+	return fx->TimingMode == FX_DURATION_JUST_EXPIRED;
+}
+
 void EffectQueue::Cleanup()
 {
 	std::list< Effect* >::iterator f;
 
+	opcodeIndex.erase(std::remove_if(opcodeIndex.begin(), opcodeIndex.end(), IsJustExpired), opcodeIndex.end());
+
 	for ( f = effects.begin(); f != effects.end(); ) {
 		if( (*f)->TimingMode == FX_DURATION_JUST_EXPIRED) {
 			delete *f;
@@ -1325,7 +1364,11 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 			}
 		}
 
+		ieDword opcode = fx->Opcode;
 		res=fn( Owner, target, fx );
+		if (fx->Opcode != opcode) {
+			RebuildIndex();
+		}
 		fx->FirstApply = 0;
 
 		//if there is no owner, we assume it is the target
@@ -1363,10 +1406,6 @@ int EffectQueue::ApplyEffect(Actor* target, Effect* fx, ieDword first_apply, ieD
 	return res;
 }
 
-// looks for opcode with param2
-
-#define MATCH_OPCODE() if((*f)->Opcode!=opcode) { continue; }
-
 // useful for: remove equipped item
 #define MATCH_SLOTCODE() if((*f)->InventorySlot!=slotcode) { continue; }
 
@@ -1391,9 +1430,8 @@ static inline bool IsLive(ieByte timingmode)
 //will be killed along with it
 void EffectQueue::RemoveAllEffects(ieDword opcode) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 
 		(*f)->TimingMode = FX_DURATION_JUST_EXPIRED;
@@ -1502,9 +1540,8 @@ void EffectQueue::RemoveAllEffects(EffectRef &effect_reference) const
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithResource(ieDword opcode, const ieResRef resource) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_RESOURCE();
 
@@ -1523,9 +1560,8 @@ void EffectQueue::RemoveAllEffectsWithResource(EffectRef &effect_reference, cons
 //(works only if a higher stat means good for the target)
 void EffectQueue::RemoveAllDetrimentalEffects(ieDword opcode, ieDword current) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		switch((*f)->Parameter2) {
 		case 0:case 3:
@@ -1557,9 +1593,8 @@ void EffectQueue::RemoveAllDetrimentalEffects(EffectRef &effect_reference, ieDwo
 //opcode need to be removed (see removal of portrait icon)
 void EffectQueue::RemoveAllEffectsWithParam(ieDword opcode, ieDword param2) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_PARAM2();
 
@@ -1577,9 +1612,8 @@ void EffectQueue::RemoveAllEffectsWithParam(EffectRef &effect_reference, ieDword
 //Removes all effects with a matching resource field
 void EffectQueue::RemoveAllEffectsWithParamAndResource(ieDword opcode, ieDword param2, const ieResRef resource) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_PARAM2();
 		if(resource[0]) {
@@ -1704,9 +1738,8 @@ void EffectQueue::DispelEffects(Effect *dispeller, ieDword level) const
 
 Effect *EffectQueue::HasOpcode(ieDword opcode) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 
 		return (*f);
@@ -1725,9 +1758,8 @@ Effect *EffectQueue::HasEffect(EffectRef &effect_reference) const
 
 Effect *EffectQueue::HasOpcodeWithParam(ieDword opcode, ieDword param2) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_PARAM2();
 
@@ -1751,9 +1783,8 @@ Effect *EffectQueue::HasEffectWithParam(EffectRef &effect_reference, ieDword par
 
 Effect *EffectQueue::HasOpcodeWithParamPair(ieDword opcode, ieDword param1, ieDword param2) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_PARAM2();
 		//0 is always accepted as first parameter
@@ -1779,9 +1810,8 @@ Effect *EffectQueue::HasEffectWithParamPair(EffectRef &effect_reference, ieDword
 //this could be used for stoneskins and mirror images as well
 void EffectQueue::DecreaseParam1OfEffect(ieDword opcode, ieDword amount) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		ieDword value = (*f)->Parameter1;
 		if( value>amount) {
@@ -1811,9 +1841,8 @@ void EffectQueue::DecreaseParam1OfEffect(EffectRef &effect_reference, ieDword am
 //returns the damage amount NOT soaked
 int EffectQueue::DecreaseParam3OfEffect(ieDword opcode, ieDword amount, ieDword param2) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_PARAM2();
 		ieDword value = (*f)->Parameter3;
@@ -1851,9 +1880,8 @@ static const int ids_stats[9]={IE_FACTION, IE_TEAM, IE_EA, IE_GENERAL, IE_RACE,
 int EffectQueue::BonusAgainstCreature(ieDword opcode, const Actor *actor) const
 {
 	int sum = 0;
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		if( (*f)->Parameter1) {
 			ieDword param1;
@@ -1904,9 +1932,8 @@ int EffectQueue::BonusAgainstCreature(EffectRef &effect_reference, const Actor *
 int EffectQueue::BonusForParam2(ieDword opcode, ieDword param2) const
 {
 	int sum = 0;
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_PARAM2();
 		sum += (*f)->Parameter1;
@@ -1927,9 +1954,8 @@ int EffectQueue::MaxParam1(ieDword opcode, bool positive) const
 {
 	int max = 0;
 	ieDwordSigned param1 = 0;
-	std::list< Effect* >::const_iterator f;
-	for (f = effects.begin(); f != effects.end(); f++) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 
 		param1 = signed((*f)->Parameter1);
@@ -1951,9 +1977,8 @@ int EffectQueue::MaxParam1(EffectRef &effect_reference, bool positive) const
 
 bool EffectQueue::WeaponImmunity(ieDword opcode, int enchantment, ieDword weapontype) const
 {
-	std::list< Effect* >::const_iterator f;
-	for (f = effects.begin(); f != effects.end(); f++) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 
 		int magic = (int) (*f)->Parameter1;
@@ -1992,9 +2017,8 @@ void EffectQueue::AddWeaponEffects(EffectQueue *fxqueue, EffectRef &fx_ref) cons
 	ieDword opcode = fx_ref.opcode;
 	Point p(-1,-1);
 
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		//
 		Effect *fx = core->GetEffect( (*f)->Resource, (*f)->Power, p);
@@ -2012,9 +2036,8 @@ int EffectQueue::SumDamageReduction(EffectRef &effect_reference, ieDword weaponE
 	int remaining = 0;
 	int count = 0;
 
-	std::list< Effect* >::const_iterator f;
-	for (f = effects.begin(); f != effects.end(); f++) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 
 		Effect* fx = *f;
@@ -2036,9 +2059,8 @@ int EffectQueue::SumDamageReduction(EffectRef &effect_reference, ieDword weaponE
 //useful for immunity vs spell, can't use item, etc.
 Effect *EffectQueue::HasOpcodeWithResource(ieDword opcode, const ieResRef resource) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_RESOURCE();
 
@@ -2062,9 +2084,8 @@ Effect *EffectQueue::HasEffectWithPower(EffectRef &effect_reference, ieDword pow
 
 Effect *EffectQueue::HasOpcodeWithPower(ieDword opcode, ieDword power) const
 {
-	std::list< Effect* >::const_iterator f;
-	for (f = effects.begin(); f != effects.end(); f++) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		// NOTE: matching greater or equals!
 		if ((*f)->Power < power) { continue; }
@@ -2090,9 +2111,8 @@ Effect *EffectQueue::HasSource(const ieResRef Removed) const
 //used in contingency/sequencer code (cannot have the same contingency twice)
 Effect *EffectQueue::HasOpcodeWithSource(ieDword opcode, const ieResRef Removed) const
 {
-	std::list< Effect* >::const_iterator f;
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		MATCH_SOURCE();
 
@@ -2223,10 +2243,8 @@ ieDword EffectQueue::CountEffects(ieDword opcode, ieDword param1, ieDword param2
 {
 	ieDword cnt = 0;
 
-	std::list< Effect* >::const_iterator f;
-
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		if( param1!=0xffffffff)
 			MATCH_PARAM1();
 		if( param2!=0xffffffff)
@@ -2244,9 +2262,8 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effect_reference, const Effe
 	ieDword cnt = 1;
 	ieDword opcode = ResolveEffect(effect_reference);
 
-	std::list< Effect* >::const_iterator f;
-	for (f = effects.begin(); f != effects.end(); ++f) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		MATCH_LIVE_FX();
 		if (*f == fx) break;
 		cnt++;
@@ -2256,10 +2273,8 @@ unsigned int EffectQueue::GetEffectOrder(EffectRef& effect_reference, const Effe
 
 void EffectQueue::ModifyEffectPoint(ieDword opcode, ieDword x, ieDword y) const
 {
-	std::list< Effect* >::const_iterator f;
-
-	for ( f = effects.begin(); f != effects.end(); f++ ) {
-		MATCH_OPCODE();
+	OpcodeRange range = GetOpcodeRange(opcode);
+	for (OpcodeIterator f = range.first; f != range.second; f++) {
 		(*f)->PosX=x;
 		(*f)->PosY=y;
 		(*f)->Parameter3=0;
@@ -35,6 +35,8 @@
 
 #include <cstdlib>
 #include <list>
+#include <utility>
+#include <vector>
 
 namespace GemRB {
 
@@ -192,6 +194,11 @@ class GEM_EXPORT EffectQueue {
 private:
 	/** List of Effects applied on the Actor */
 	std::list< Effect* > effects;
+	/** The same effects sorted by opcode, keeping their queue order
+	 *  within each opcode, so the opcode lookups don't walk the whole list */
+	mutable std::vector< Effect* > opcodeIndex;
+	typedef std::vector< Effect* >::const_iterator OpcodeIterator;
+	typedef std::pair< OpcodeIterator, OpcodeIterator > OpcodeRange;
 	/** Actor which is target of the Effects */
 	Scriptable* Owner;
 
@@ -316,6 +323,10 @@ public:
 	static bool OverrideTarget(const Effect *fx);
 	bool HasHostileEffects() const;
 private:
+	/** returns the indexed effects with the given opcode */
+	OpcodeRange GetOpcodeRange(ieDword opcode) const;
+	void UnindexEffect(const Effect *fx);
+	void RebuildIndex() const;
 	/** counts effects of specific opcode, parameters and resource */
 	ieDword CountEffects(ieDword opcode, ieDword param1, ieDword param2, const char *ResRef) const;
 	void ModifyEffectPoint(ieDword opcode, ieDword x, ieDword y) const;
@@ -21,11 +21,31 @@
 #include "Compressor.h"
 #include "Interface.h"
 #include "PluginMgr.h"
+#include "ResourceManager.h"
 #include "System/FileStream.h"
+#include "System/MemoryStream.h"
 #include "System/VFS.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
+struct PendingFile {
+	void *data;
+	ieDword length;
+};
+
+static std::map<std::string, PendingFile> PendingFiles;
+
+static std::string PendingKey(const char* filename)
+{
+	char fname[_MAX_PATH];
+	ExtractFileFromPath(fname, filename);
+	strlwr(fname);
+	return fname;
+}
+
 DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int length, bool overwrite)
 {
 	if (!core->IsAvailable(PLUGIN_COMPRESSION_ZLIB)) {
@@ -54,4 +74,82 @@ DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int
 	return FileStream::OpenFile(path);
 }
 
+void AddPendingCacheFile(const char* filename, void* compressed, ieDword length)
+{
+	PendingFile &file = PendingFiles[PendingKey(filename)];
+	//a later member of the same name wins, like it did when extracting
+	free(file.data);
+	file.data = compressed;
+	file.length = length;
+	ResourceManager::InvalidateLookups();
+}
+
+bool HasPendingCacheFile(const char* filename)
+{
+	if (PendingFiles.empty()) {
+		return false;
+	}
+	return PendingFiles.find(PendingKey(filename)) != PendingFiles.end();
+}
+
+DataStream* ExtractPendingCacheFile(const char* filename)
+{
+	std::map<std::string, PendingFile>::iterator it = PendingFiles.find(PendingKey(filename));
+	if (it == PendingFiles.end()) {
+		return NULL;
+	}
+
+	char name[_MAX_PATH];
+	strlcpy(name, it->first.c_str(), _MAX_PATH);
+	//the stream frees its buffer, so it gets a copy; the member stays
+	//pending until it was really written to the cache
+	int length = it->second.length;
+	void *copy = malloc(length);
+	memcpy(copy, it->second.data, length);
+	MemoryStream compressed(name, copy, length);
+	DataStream *str = CacheCompressedStream(&compressed, name, length, true);
+	if (str) {
+		free(it->second.data);
+		PendingFiles.erase(it);
+	}
+	return str;
+}
+
+bool ExtractPendingCacheFiles()
+{
+	bool ret = true;
+	std::map<std::string, PendingFile>::iterator it = PendingFiles.begin();
+	while (it != PendingFiles.end()) {
+		std::string name = (it++)->first;
+		DataStream *str = ExtractPendingCacheFile(name.c_str());
+		if (!str) {
+			Log(ERROR, "FileCache", "Failed to extract %s.", name.c_str());
+			ret = false;
+		}
+		delete str;
+	}
+	return ret;
+}
+
+void DropPendingCacheFile(const char* filename)
+{
+	if (PendingFiles.empty()) {
+		return;
+	}
+	std::map<std::string, PendingFile>::iterator it = PendingFiles.find(PendingKey(filename));
+	if (it != PendingFiles.end()) {
+		free(it->second.data);
+		PendingFiles.erase(it);
+	}
+}
+
+void ClearPendingCacheFiles()
+{
+	std::map<std::string, PendingFile>::iterator it;
+	for (it = PendingFiles.begin(); it != PendingFiles.end(); ++it) {
+		free(it->second.data);
+	}
+	PendingFiles.clear();
+}
+
 }
@@ -25,6 +25,20 @@ namespace GemRB {
 
 GEM_EXPORT DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int length = 0, bool overwrite = false);
 
+/* members of the loaded saved game, kept compressed until first requested;
+   the buffer passed in is owned (and freed) by the cache */
+GEM_EXPORT void AddPendingCacheFile(const char* filename, void* compressed, ieDword length);
+GEM_EXPORT bool HasPendingCacheFile(const char* filename);
+/* inflates a pending member into the cache and returns it, NULL if not pending
+   or on failure, in which case the member stays pending */
+GEM_EXPORT DataStream* ExtractPendingCacheFile(const char* filename);
+/* inflates every pending member, needed before the cache is written out;
+   false if any of them failed */
+GEM_EXPORT bool ExtractPendingCacheFiles();
+/* forgets a pending member whose cached file was replaced or removed */
+GEM_EXPORT void DropPendingCacheFile(const char* filename);
+GEM_EXPORT void ClearPendingCacheFiles();
+
 }
 
 #endif
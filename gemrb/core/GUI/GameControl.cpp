@@ -848,7 +848,7 @@ bool GameControl::OnKeyRelease(unsigned char Key, unsigned short Mod)
 			case 'k': //kicks out actor
 				if (lastActor && lastActor->InParty) {
 					lastActor->Stop();
-					lastActor->AddAction( GenerateAction("LeaveParty()") );
+					lastActor->AddAction( GenerateCachedAction("LeaveParty()") );
 				}
 				break;
 			case 'l': //play an animation (vvc/bam) over an actor
@@ -926,7 +926,7 @@ bool GameControl::OnKeyRelease(unsigned char Key, unsigned short Mod)
 			case 'q': //joins actor to the party
 				if (lastActor && !lastActor->InParty) {
 					lastActor->Stop();
-					lastActor->AddAction( GenerateAction("JoinParty()") );
+					lastActor->AddAction( GenerateCachedAction("JoinParty()") );
 				}
 				break;
 			case 'r'://resurrects actor
@@ -1757,7 +1757,7 @@ void GameControl::HandleContainer(Container *container, Actor *actor)
 
 	container->AddTrigger(TriggerEntry(trigger_clicked, actor->GetGlobalID()));
 	core->SetCurrentContainer( actor, container);
-	actor->CommandActor(GenerateAction("UseContainer()"));
+	actor->CommandActor(GenerateCachedAction("UseContainer()"));
 }
 
 //generate action code for actor appropriate for the target mode when the target is a door
@@ -1792,7 +1792,7 @@ void GameControl::HandleDoor(Door *door, Actor *actor)
 	door->AddTrigger(TriggerEntry(trigger_clicked, actor->GetGlobalID()));
 	actor->TargetDoor = door->GetGlobalID();
 	// internal gemrb toggle door action hack - should we use UseDoor instead?
-	actor->CommandActor(GenerateAction("NIDSpecial9()"));
+	actor->CommandActor(GenerateCachedAction("NIDSpecial9()"));
 }
 
 //generate action code for actor appropriate for the target mode when the target is an active region (infopoint, trap or travel)
@@ -1820,7 +1820,7 @@ bool GameControl::HandleActiveRegion(InfoPoint *trap, Actor * actor, Point &p)
 		case ST_TRIGGER:
 			// pst, eg. ar1500
 			if (trap->GetDialog()[0]) {
-				trap->AddAction(GenerateAction("Dialogue([PC])"));
+				trap->AddAction(GenerateCachedAction("Dialogue([PC])"));
 				return true;
 			}
 
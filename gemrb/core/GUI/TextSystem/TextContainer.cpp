@@ -340,9 +340,10 @@ void ContentContainer::InsertContentAfter(Content* newContent, const Content* ex
 		contents.push_front(newContent);
 		LayoutContentsFrom(contents.begin());
 	} else {
+		// search from the back since we are usually appending
 		ContentList::iterator it;
-		it = std::find(contents.begin(), contents.end(), existing);
-		contents.insert(++it, newContent);
+		it = std::find(contents.rbegin(), contents.rend(), existing).base();
+		contents.insert(it, newContent);
 		LayoutContentsFrom(--it);
 	}
 }
@@ -406,17 +407,24 @@ Region ContentContainer::BoundingBoxForContent(const Content* c) const
 
 const ContentContainer::Layout& ContentContainer::LayoutForContent(const Content* c) const
 {
-	ContentLayout::const_iterator it = std::find(layout.begin(), layout.end(), c);
-	if (it != layout.end()) {
+	// the content we are after is most often the last one laid out
+	ContentLayout::const_reverse_iterator it = std::find(layout.rbegin(), layout.rend(), c);
+	if (it != layout.rend()) {
 		return *it;
 	}
 	static Layout NullLayout(NULL, Regions());
 	return NullLayout;
 }
 
+ContentContainer::ContentLayout::const_iterator ContentContainer::LayoutBelow(int y) const
+{
+	return std::upper_bound(layout.begin(), layout.end(), y, Layout::ExtentBelow);
+}
+
 const Region* ContentContainer::ContentRegionForRect(const Region& r) const
 {
-	ContentLayout::const_iterator it = layout.begin();
+	// nothing before this can reach down into r
+	ContentLayout::const_iterator it = LayoutBelow(r.y);
 	for (; it != layout.end(); ++it) {
 		const Regions& rgns = (*it).regions;
 		Regions::const_iterator rit = rgns.begin();
@@ -470,14 +478,24 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 		it++;
 	}
 	// clear the existing layout, but only for "it" and onward
-	ContentList::const_iterator clearit = it;
-	for (; clearit != contents.end(); ++clearit) {
-		ContentLayout::iterator i = std::find(layout.begin(), layout.end(), *clearit);
-		if (i != layout.end()) {
-			layoutPoint = Point(); // reset cached layoutPoint
-			layout.erase(i);
+	// the layout is in content order, so that is everything after the layout of exContent
+	ContentLayout::iterator clearit = layout.begin();
+	if (exContent) {
+		clearit = std::find(layout.rbegin(), layout.rend(), exContent).base();
+		if (clearit == layout.begin()) {
+			// exContent was never laid out; start over
+			exContent = NULL;
+			it = contents.begin();
 		}
 	}
+	if (clearit != layout.end()) {
+		layoutPoint = Point(); // reset cached layoutPoint
+		layout.erase(clearit, layout.end());
+	}
+	if (!layout.empty()) {
+		// the retained layout still counts towards our bounds
+		contentBounds = layout.back().extent;
+	}
 
 	while (it != contents.end()) {
 		const Content* content = *it++;
@@ -504,9 +522,12 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 		}
 		const Regions& rgns = content->LayoutForPointInRegion(layoutPoint, frame);
 		layout.push_back(Layout(content, rgns));
-		const Region& bounds = Region::RegionEnclosingRegions(rgns);
-		contentBounds.h = (bounds.y + bounds.h > contentBounds.h) ? bounds.y + bounds.h : contentBounds.h;
-		contentBounds.w = (bounds.x + bounds.w > contentBounds.w) ? bounds.x + bounds.w : contentBounds.w;
+		if (rgns.size()) {
+			const Region& bounds = Region::RegionEnclosingRegions(rgns);
+			contentBounds.h = (bounds.y + bounds.h > contentBounds.h) ? bounds.y + bounds.h : contentBounds.h;
+			contentBounds.w = (bounds.x + bounds.w > contentBounds.w) ? bounds.x + bounds.w : contentBounds.w;
+		}
+		layout.back().extent = contentBounds;
 		exContent = content;
 	}
 	if (parent) {
@@ -523,11 +544,14 @@ void ContentContainer::DrawContentsInRegions(const Regions& rgns, const Point& o
 	// should only have 1 region
 	const Region& rgn = rgns.front();
 
-	// TODO: intersect with the screen clip so we can bail out even earlier
+	// only visit the layouts inside the screen clip (the visible scroll window)
+	const Region& clip = core->GetVideoDriver()->GetScreenClip();
+	int clipTop = clip.y - (offset.y + parentOffset.y);
+	int clipBottom = clipTop + clip.h;
 
 	const Point& drawOrigin = rgn.Origin();
 	Point drawPoint = drawOrigin;
-	ContentLayout::const_iterator it = layout.begin();
+	ContentLayout::const_iterator it = LayoutBelow(clipTop);
 
 #if (DEBUG_TEXT)
 	Region dr(parentOffset + offset, contentBounds);
@@ -540,6 +564,9 @@ void ContentContainer::DrawContentsInRegions(const Regions& rgns, const Point& o
 
 	for (; it != layout.end(); ++it) {
 		const Layout& l = *it;
+		if (l.regions.size() && l.regions.front().y >= clipBottom) {
+			break; // layouts are ordered ttb, so the rest is below the clip too
+		}
 		assert(drawPoint.x <= drawOrigin.x + frame.w);
 		l.content->DrawContentsInRegions(l.regions, offset + parentOffset);
 	}
@@ -114,10 +114,17 @@ protected:
 	struct Layout {
 		const Content* content;
 		Regions regions;
+		// the furthest right and bottom edges reached by this and all the preceding layouts
+		// never shrinks along the layout so we can binary search it
+		Size extent;
 
 		Layout(const Content* c, const Regions r)
 		: content(c), regions(r) {}
 
+		static bool ExtentBelow(int y, const Layout& l) {
+			return y < l.extent.h;
+		}
+
 		bool operator==(const Content* c) const {
 			return c == content;
 		}
@@ -171,6 +178,8 @@ protected:
 	void LayoutContentsFrom(const Content*);
 	Content* RemoveContent(const Content* content, bool doLayout);
 	const Layout& LayoutForContent(const Content*) const;
+	// the first layout that may reach below y
+	ContentLayout::const_iterator LayoutBelow(int y) const;
 };
 
 // TextContainers can hold any content, but they represent a string of text that is divided into TextSpans
@@ -26,6 +26,7 @@
 #include "strrefs.h"
 #include "win32def.h"
 
+#include "AreaPrefetcher.h"
 #include "DisplayMessage.h"
 #include "GameData.h"
 #include "Interface.h"
@@ -115,6 +116,7 @@ Game::Game(void) : Scriptable( ST_GLOBAL )
 	event_handler = NULL;
 	weather = new Particles(200);
 	weather->SetRegion(0, 0, core->Width, core->Height);
+	prefetcher = new AreaPrefetcher();
 	LastScriptUpdate = 0;
 	WhichFormation = 0;
 	NpcInParty = 0;
@@ -184,6 +186,8 @@ Game::Game(void) : Scriptable( ST_GLOBAL )
 Game::~Game(void)
 {
 	delete weather;
+	delete prefetcher;
+	gamedata->ClearPrefetched();
 	for (auto map : Maps) {
 		delete map;
 	}
@@ -1633,6 +1637,24 @@ void Game::UpdateScripts()
 		core->GetGUIScriptEngine()->RunFunction("GUIWORLD", "OpenReformPartyWindow");
 		return;
 	}
+
+	// use the quiet moments to read ahead the areas we may travel to
+	if (PartyIdle()) {
+		prefetcher->Update(GetCurrentArea());
+	}
+}
+
+bool Game::PartyIdle() const
+{
+	if (CombatCounter || core->InCutSceneMode()) {
+		return false;
+	}
+	for (auto pc : PCs) {
+		if (pc->InMove()) {
+			return false;
+		}
+	}
+	return true;
 }
 
 void Game::SetTimedEvent(EventHandler func, int count)
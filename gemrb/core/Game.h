@@ -42,6 +42,7 @@
 namespace GemRB {
 
 class Actor;
+class AreaPrefetcher;
 class Map;
 class Particles;
 class TableMgr;
@@ -261,6 +262,7 @@ private:
 	ieResRef daymovies[8];
 	ieResRef nightmovies[8];
 	int MapIndex;
+	AreaPrefetcher *prefetcher;
 public:
 	std::vector< Actor*> selected;
 	int version;
@@ -510,6 +512,7 @@ public:
 	void ReversePCs();
 private:
 	bool DetermineStartPosType(const TableMgr *strta);
+	bool PartyIdle() const;
 	ieResRef *GetDream(Map *area);
 	void CastOnRest();
 	void PlayerDream();
@@ -35,6 +35,7 @@
 #include "Interface.h"
 #include "Item.h"
 #include "ItemMgr.h"
+#include "Palette.h"
 #include "PluginMgr.h"
 #include "ResourceDesc.h"
 #include "ScriptedAnimation.h"
@@ -45,6 +46,7 @@
 #include "Scriptable/Actor.h"
 #include "System/FileStream.h"
 
+#include <algorithm>
 #include <cstdio>
 
 namespace GemRB {
@@ -72,25 +74,107 @@ static void ReleasePalette(void *poi)
 	((Palette *) poi)->release();
 }
 
+//upper limit for resources read ahead of time (prefetched area tilesets)
+#define PREFETCH_BUDGET (48*1024*1024)
+
 GEM_EXPORT GameData* gamedata;
 
 GameData::GameData()
 {
 	factory = new Factory();
+	InternPurgeSize = 64;
+	prefetchedSize = 0;
 }
 
 GameData::~GameData()
 {
 	delete factory;
 	ItemSounds.clear();
+	ClearPrefetched();
+}
+
+DataStream* GameData::GetResource(const char* resname, SClass_ID type, bool silent)
+{
+	if (!prefetched.empty() && resname[0]) {
+		DataStream *ds = TakePrefetched(resname, type);
+		if (ds) {
+			if (!silent) {
+				Log(MESSAGE, "GameData", "Found '%s.%s' in prefetched data.",
+					resname, core->TypeExt(type));
+			}
+			return ds;
+		}
+	}
+	return ResourceManager::GetResource(resname, type, silent);
 }
 
+bool GameData::AddPrefetched(const char *ResRef, SClass_ID type, DataStream *stream)
+{
+	unsigned long size = stream->Size();
+	if (size > PREFETCH_BUDGET || IsPrefetched(ResRef, type)) {
+		delete stream;
+		return false;
+	}
+
+	while (prefetchedSize + size > PREFETCH_BUDGET) {
+		prefetchedSize -= prefetched.front().stream->Size();
+		delete prefetched.front().stream;
+		prefetched.erase(prefetched.begin());
+	}
+
+	PrefetchedResource res;
+	CopyResRef(res.ResRef, ResRef);
+	res.type = type;
+	res.stream = stream;
+	prefetched.push_back(res);
+	prefetchedSize += size;
+	return true;
+}
+
+bool GameData::IsPrefetched(const char *ResRef, SClass_ID type) const
+{
+	for (size_t i = 0; i < prefetched.size(); i++) {
+		if (prefetched[i].type == type && !strnicmp(prefetched[i].ResRef, ResRef, 8)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+DataStream* GameData::TakePrefetched(const char *ResRef, SClass_ID type)
+{
+	for (size_t i = 0; i < prefetched.size(); i++) {
+		if (prefetched[i].type == type && !strnicmp(prefetched[i].ResRef, ResRef, 8)) {
+			DataStream *ds = prefetched[i].stream;
+			prefetchedSize -= ds->Size();
+			prefetched.erase(prefetched.begin() + i);
+			return ds;
+		}
+	}
+	return NULL;
+}
+
+void GameData::ClearPrefetched()
+{
+	for (size_t i = 0; i < prefetched.size(); i++) {
+		delete prefetched[i].stream;
+	}
+	prefetched.clear();
+	prefetchedSize = 0;
+}
+
+
 void GameData::ClearCaches()
 {
 	ItemCache.RemoveAll(ReleaseItem);
 	SpellCache.RemoveAll(ReleaseSpell);
 	EffectCache.RemoveAll(ReleaseEffect);
 	PaletteCache.RemoveAll(ReleasePalette);
+	std::multimap<ieDword, Palette*>::iterator pit = InternedPalettes.begin();
+	for (; pit != InternedPalettes.end(); ++pit) {
+		pit->second->release();
+	}
+	InternedPalettes.clear();
 
 	while (!stores.empty()) {
 		Store *store = stores.begin()->second;
@@ -291,6 +375,61 @@ void GameData::FreePalette(Palette *&pal, const ieResRef name)
 	pal = NULL;
 }
 
+static ieDword HashPalette(const Palette* pal)
+{
+	// FNV-1a
+	const unsigned char* data = (const unsigned char*) pal->col;
+	ieDword hash = 2166136261u;
+	for (size_t i = 0; i < sizeof(pal->col); i++) {
+		hash = (hash ^ data[i]) * 16777619u;
+	}
+	return hash ^ pal->alpha;
+}
+
+Palette* GameData::InternPalette(Palette* pal)
+{
+	if (!pal || pal->named) {
+		return pal;
+	}
+
+	ieDword hash = HashPalette(pal);
+	std::pair<std::multimap<ieDword, Palette*>::iterator, std::multimap<ieDword, Palette*>::iterator> range;
+	range = InternedPalettes.equal_range(hash);
+	for (; range.first != range.second; ++range.first) {
+		Palette* shared = range.first->second;
+		if (shared == pal) {
+			return pal;
+		}
+		if (shared->alpha == pal->alpha && *shared == *pal) {
+			shared->acquire();
+			pal->release();
+			return shared;
+		}
+	}
+
+	if (InternedPalettes.size() >= InternPurgeSize) {
+		PurgeInternedPalettes();
+	}
+	pal->acquire();
+	InternedPalettes.insert(std::make_pair(hash, pal));
+	return pal;
+}
+
+// drop the palettes nobody but us uses anymore
+void GameData::PurgeInternedPalettes()
+{
+	std::multimap<ieDword, Palette*>::iterator it = InternedPalettes.begin();
+	while (it != InternedPalettes.end()) {
+		if (it->second->IsShared()) {
+			++it;
+		} else {
+			it->second->release();
+			InternedPalettes.erase(it++);
+		}
+	}
+	InternPurgeSize = std::max<size_t>(64, InternedPalettes.size() * 2);
+}
+
 Item* GameData::GetItem(const ieResRef resname, bool silent)
 {
 	Item *item = (Item *) ItemCache.GetResource(resname);
@@ -64,6 +64,20 @@ public:
 
 	void ClearCaches();
 
+	using ResourceManager::GetResource;
+	/** Same as ResourceManager::GetResource, but hands over prefetched data first */
+	DataStream* GetResource(const char* resname, SClass_ID type, bool silent = false);
+
+	/**
+	 * Keeps an in-memory copy of a resource read ahead of time.
+	 * The next GetResource for it hands the stream over instead of
+	 * searching the paths. The oldest copies are dropped to stay
+	 * within the memory budget.
+	 **/
+	bool AddPrefetched(const char *ResRef, SClass_ID type, DataStream *stream);
+	bool IsPrefetched(const char *ResRef, SClass_ID type) const;
+	void ClearPrefetched();
+
 	/** Returns actor */
 	Actor *GetCreature(const char *ResRef, unsigned int PartySlot=0);
 	/** Returns a PC index, by loading a creature */
@@ -84,6 +98,9 @@ public:
 
 	Palette* GetPalette(const ieResRef resname);
 	void FreePalette(Palette *&pal, const ieResRef name=NULL);
+	/** Returns the shared palette with the same colours as pal, which is released.
+	 * Shared palettes must not be changed in place, copy them first. */
+	Palette* InternPalette(Palette* pal);
 	
 	Item* GetItem(const ieResRef resname, bool silent=false);
 	void FreeItem(Item const *itm, const ieResRef name, bool free=false);
@@ -117,12 +134,25 @@ public:
 
 	int GetRacialTHAC0Bonus(ieDword proficiency, const char *raceName);
 private:
+	struct PrefetchedResource {
+		ieResRef ResRef;
+		SClass_ID type;
+		DataStream *stream;
+	};
+
 	void ReadItemSounds();
+	void PurgeInternedPalettes();
+	DataStream* TakePrefetched(const char *ResRef, SClass_ID type);
 private:
+	std::vector<PrefetchedResource> prefetched;
+	unsigned long prefetchedSize;
 	Cache ItemCache;
 	Cache SpellCache;
 	Cache EffectCache;
 	Cache PaletteCache;
+	// unnamed palettes keyed by a hash of their colours, each holding a reference
+	std::multimap<ieDword, Palette*> InternedPalettes;
+	size_t InternPurgeSize;
 	Factory* factory;
 	std::vector<Table> tables;
 	typedef std::map<const char*, Store*, iless> StoreMap;
@@ -2280,6 +2280,117 @@ ieDword CheckVariable(Scriptable* Sender, const char* VarName, const char* Conte
 	return value;
 }
 
+VariableRef::VariableRef(const char *VarName)
+{
+	const char *poi = &VarName[6];
+	//some HoW triggers use a : to separate the scope from the variable name
+	if (*poi==':') {
+		poi++;
+	}
+	hasContext = false;
+	SetScope(VarName);
+	name.SetKey(poi);
+}
+
+VariableRef::VariableRef(const char *VarName, const char *Context)
+{
+	hasContext = true;
+	SetScope(Context);
+	name.SetKey(VarName);
+}
+
+void VariableRef::SetScope(const char *Context)
+{
+	strlcpy(scopeName, Context, 7);
+	if (stricmp(scopeName, "MYAREA") == 0) {
+		scope = VS_MYAREA;
+	} else if (stricmp(scopeName, "LOCALS") == 0) {
+		scope = VS_LOCALS;
+	} else if (HasKaputz && !stricmp(scopeName, "KAPUTZ")) {
+		scope = VS_KAPUTZ;
+	} else if (stricmp(scopeName, "GLOBAL")) {
+		scope = VS_AREA;
+	} else {
+		scope = VS_GLOBAL;
+	}
+}
+
+void SetVariable(Scriptable* Sender, const VariableRef &var, ieDword value)
+{
+	if (InDebug&ID_VARIABLES) {
+		Log(DEBUG, "GSUtils", "Setting variable(\"%s%s\", %d)", var.scopeName,
+			var.name.GetKey(), value );
+	}
+
+	Game *game = core->GetGame();
+	switch (var.scope) {
+	case VS_MYAREA:
+		Sender->GetCurrentArea()->locals->SetAt( var.name, value, NoCreate );
+		break;
+	case VS_LOCALS:
+		Sender->locals->SetAt( var.name, value, NoCreate );
+		break;
+	case VS_KAPUTZ:
+		game->kaputz->SetAt( var.name, value, !var.hasContext && NoCreate );
+		break;
+	case VS_GLOBAL:
+		game->locals->SetAt( var.name, value, NoCreate );
+		break;
+	default:
+		Map *map = game->GetMap(game->FindMap(var.scopeName));
+		if (map) {
+			map->locals->SetAt( var.name, value, NoCreate);
+		} else if (InDebug&ID_VARIABLES) {
+			Log(WARNING, "GameScript", "Invalid variable %s %s in setvariable",
+				var.scopeName, var.name.GetKey());
+		}
+		break;
+	}
+}
+
+ieDword CheckVariable(Scriptable* Sender, const VariableRef &var, bool *valid)
+{
+	ieDword value = 0;
+
+	Game *game = core->GetGame();
+	switch (var.scope) {
+	case VS_MYAREA:
+		Sender->GetCurrentArea()->locals->Lookup( var.name, value );
+		break;
+	case VS_LOCALS:
+		if (!Sender->locals->Lookup( var.name, value ) && var.hasContext) {
+			if (valid) {
+				*valid = false;
+			}
+		}
+		break;
+	case VS_KAPUTZ:
+		game->kaputz->Lookup( var.name, value );
+		break;
+	case VS_GLOBAL:
+		game->locals->Lookup( var.name, value );
+		break;
+	default:
+		Map *map = game->GetMap(game->FindMap(var.scopeName));
+		if (map) {
+			map->locals->Lookup( var.name, value );
+		} else {
+			if (valid) {
+				*valid = false;
+			}
+			if (InDebug&ID_VARIABLES) {
+				Log(WARNING, "GameScript", "Invalid variable %s %s in checkvariable",
+					var.scopeName, var.name.GetKey());
+			}
+		}
+		break;
+	}
+	if (InDebug&ID_VARIABLES) {
+		print("CheckVariable %s%s: %d", var.scopeName, var.name.GetKey(), value);
+	}
+	return value;
+}
+
 // checks if a variable exists in any context
 bool VariableExists(Scriptable *Sender, const char *VarName, const char *Context)
 {
@@ -55,6 +55,9 @@
 #include "RNG/RNG_SFMT.h"
 #include "System/StringBuffer.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
 //debug flags
@@ -1361,9 +1364,18 @@ void Targets::dump() const
 	}
 }
 
+//parsed forms of the fixed actions the engine issues itself, see GenerateCachedAction
+#define MAX_ACTION_TEMPLATES 256
+static std::map<std::string, Action*> actionTemplates;
+
 /** releasing global memory */
 static void CleanupIEScript()
 {
+	std::map<std::string, Action*>::iterator it;
+	for (it = actionTemplates.begin(); it != actionTemplates.end(); ++it) {
+		it->second->Release();
+	}
+	actionTemplates.clear();
 	triggersTable.release();
 	actionsTable.release();
 	objectsTable.release();
@@ -2353,6 +2365,33 @@ int Trigger::Evaluate(Scriptable* Sender)
 	return ret;
 }
 
+const VariableRef& Trigger::GetVariable(int idx, const char *Context)
+{
+	// resolved on first use, afterwards the scope and hash are reused
+	if (!variables[idx]) {
+		const char *VarName = idx ? string1Parameter : string0Parameter;
+		if (Context) {
+			variables[idx] = new VariableRef(VarName, Context);
+		} else {
+			variables[idx] = new VariableRef(VarName);
+		}
+	}
+	return *variables[idx];
+}
+
+const VariableRef& Action::GetVariable(int idx, const char *Context)
+{
+	if (!variables[idx]) {
+		const char *VarName = idx ? string1Parameter : string0Parameter;
+		if (Context) {
+			variables[idx] = new VariableRef(VarName, Context);
+		} else {
+			variables[idx] = new VariableRef(VarName);
+		}
+	}
+	return *variables[idx];
+}
+
 int ResponseSet::Execute(Scriptable* Sender)
 {
 	size_t i;
@@ -2585,9 +2624,66 @@ Action* GenerateAction(const char* String)
 	return action;
 }
 
+static bool SameObject(const Object *a, const Object *b)
+{
+	if (!a || !b) {
+		return a == b;
+	}
+	return !memcmp(a->objectFields, b->objectFields, sizeof(a->objectFields)) &&
+		!memcmp(a->objectFilters, b->objectFilters, sizeof(a->objectFilters)) &&
+		!memcmp(a->objectRect, b->objectRect, sizeof(a->objectRect)) &&
+		!strcmp(a->objectName, b->objectName);
+}
+
+//checks a copy of a kept action against what the parser makes of its string
+static void VerifyCachedAction(const char* String, const Action *copy)
+{
+	Action *fresh = GenerateAction(String);
+	if (!fresh) {
+		return;
+	}
+	bool same = fresh->actionID == copy->actionID &&
+		fresh->int0Parameter == copy->int0Parameter &&
+		fresh->int1Parameter == copy->int1Parameter &&
+		fresh->int2Parameter == copy->int2Parameter &&
+		fresh->pointParameter == copy->pointParameter &&
+		!strcmp(fresh->string0Parameter, copy->string0Parameter) &&
+		!strcmp(fresh->string1Parameter, copy->string1Parameter) &&
+		fresh->flags == copy->flags;
+	for (int c = 0; same && c < 3; c++) {
+		same = SameObject(fresh->objects[c], copy->objects[c]);
+	}
+	if (!same) {
+		Log(ERROR, "GameScript", "Cached action differs from the parsed one: %s", String);
+	}
+	delete fresh;
+}
+
+//same as GenerateAction, but the string is only parsed the first time,
+//later calls get a copy of the kept action
+Action* GenerateCachedAction(const char* String)
+{
+	std::map<std::string, Action*>::iterator it = actionTemplates.find(String);
+	if (it != actionTemplates.end()) {
+		Action *action = ParamCopy(it->second);
+		if (InDebug&ID_ACTIONS) {
+			VerifyCachedAction(String, action);
+		}
+		return action;
+	}
+
+	Action *action = GenerateAction(String);
+	if (!action || actionTemplates.size() >= MAX_ACTION_TEMPLATES) {
+		return action;
+	}
+	action->IncRef();
+	actionTemplates[String] = action;
+	return ParamCopy(action);
+}
+
 Action* GenerateActionDirect(const char *String, Scriptable *object)
 {
-	Action* action = GenerateAction(String);
+	Action* action = GenerateCachedAction(String);
 	if (!action) return NULL;
 	Object *tmp = action->objects[1];
 	if (tmp && tmp->objectFields[0]==-1) {
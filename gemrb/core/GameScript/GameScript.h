@@ -223,10 +223,36 @@ public:
 	bool isNull();
 };
 
+//variable scopes
+#define VS_GLOBAL  0
+#define VS_LOCALS  1
+#define VS_MYAREA  2
+#define VS_KAPUTZ  3
+#define VS_AREA    4
+
+//a scoped script variable, split and hashed only once per trigger or action
+class GEM_EXPORT VariableRef {
+public:
+	//the combined form, eg. "GLOBALfoo" or "AR0100:foo"
+	explicit VariableRef(const char *VarName);
+	//separate name and scope, eg. ("foo", "GLOBAL")
+	explicit VariableRef(const char *VarName, const char *Context);
+private:
+	void SetScope(const char *Context);
+public:
+	int scope;
+	//the context form also reports missing locals as invalid
+	bool hasContext;
+	char scopeName[7];
+	Variables::Handle name;
+};
+
 class GEM_EXPORT Trigger : protected Canary {
 public:
 	Trigger()
 	{
+		variables[0] = NULL;
+		variables[1] = NULL;
 		triggerID = 0;
 		flags = 0;
 		objectParameter = NULL;
@@ -243,8 +269,14 @@ public:
 			objectParameter->Release();
 			objectParameter = NULL;
 		}
+		delete variables[0];
+		delete variables[1];
 	}
 	int Evaluate(Scriptable* Sender);
+	//the variable named by string0Parameter (idx 0) or string1Parameter (idx 1)
+	const VariableRef& GetVariable(int idx, const char *Context = NULL);
+private:
+	VariableRef *variables[2];
 public:
 	unsigned short triggerID;
 	int int0Parameter;
@@ -290,6 +322,8 @@ class GEM_EXPORT Action : protected Canary {
 public:
 	Action(bool autoFree)
 	{
+		variables[0] = NULL;
+		variables[1] = NULL;
 		actionID = 0;
 		objects[0] = NULL;
 		objects[1] = NULL;
@@ -316,7 +350,11 @@ public:
 				objects[c] = NULL;
 			}
 		}
+		delete variables[0];
+		delete variables[1];
 	}
+	//the variable named by string0Parameter (idx 0) or string1Parameter (idx 1)
+	const VariableRef& GetVariable(int idx, const char *Context = NULL);
 public:
 	unsigned short actionID;
 	Object* objects[3];
@@ -329,6 +367,7 @@ public:
 	unsigned short flags;
 private:
 	int RefCount;
+	VariableRef *variables[2];
 public:
 	int GetRef() {
 		return RefCount;
@@ -1550,6 +1589,8 @@ public:
 };
 
 GEM_EXPORT Action* GenerateAction(const char* String);
+/** for fixed action strings, parses them only once */
+GEM_EXPORT Action* GenerateCachedAction(const char* String);
 Action* GenerateActionDirect(const char* String, Scriptable *object);
 GEM_EXPORT Trigger* GenerateTrigger(char* String);
 
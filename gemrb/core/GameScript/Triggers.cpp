@@ -454,7 +454,7 @@ int GameScript::BitCheck(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		if ( value & parameters->int0Parameter ) return 1;
 	}
@@ -465,7 +465,7 @@ int GameScript::BitCheckExact(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		ieDword tmp = (ieDword) parameters->int0Parameter ;
 		if ((value & tmp) == tmp) return 1;
@@ -479,7 +479,7 @@ int GameScript::BitGlobal_Trigger(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		HandleBitMod(value, parameters->int0Parameter, parameters->int1Parameter);
 		if (value!=0) return 1;
@@ -491,10 +491,10 @@ int GameScript::GlobalOrGlobal_Trigger(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		if ( value1 ) return 1;
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, &valid );
+		ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1), &valid );
 		if (valid) {
 			if ( value2 ) return 1;
 		}
@@ -506,9 +506,9 @@ int GameScript::GlobalAndGlobal_Trigger(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable( Sender, parameters->string0Parameter, &valid );
+	ieDword value1 = CheckVariable( Sender, parameters->GetVariable(0), &valid );
 	if (valid && value1) {
-		ieDword value2 = CheckVariable( Sender, parameters->string1Parameter, &valid );
+		ieDword value2 = CheckVariable( Sender, parameters->GetVariable(1), &valid );
 		if (valid && value2) return 1;
 	}
 	return 0;
@@ -518,9 +518,9 @@ int GameScript::GlobalBAndGlobal_Trigger(Scriptable* Sender, Trigger* parameters
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, &valid );
+		ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1), &valid );
 		if (valid) {
 			if ((value1& value2 ) != 0) return 1;
 		}
@@ -532,9 +532,9 @@ int GameScript::GlobalBAndGlobalExact(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, &valid );
+		ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1), &valid );
 		if (valid) {
 			if (( value1& value2 ) == value2) return 1;
 		}
@@ -546,9 +546,9 @@ int GameScript::GlobalBitGlobal_Trigger(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
-		ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, &valid );
+		ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1), &valid );
 		if (valid) {
 			HandleBitMod( value1, value2, parameters->int1Parameter);
 			if (value1!=0) return 1;
@@ -561,7 +561,7 @@ int GameScript::GlobalBitGlobal_Trigger(Scriptable* Sender, Trigger* parameters)
 //i just assume it sets a global in the trigger block
 int GameScript::TriggerSetGlobal(Scriptable* Sender, Trigger* parameters)
 {
-	SetVariable( Sender, parameters->string0Parameter, parameters->int0Parameter );
+	SetVariable( Sender, parameters->GetVariable(0), parameters->int0Parameter );
 	return 1;
 }
 
@@ -570,7 +570,7 @@ int GameScript::Xor(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDword value = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		if (( value ^ parameters->int0Parameter ) != 0) return 1;
 	}
@@ -584,7 +584,7 @@ int GameScript::NumDead(Scriptable* Sender, Trigger* parameters)
 	ieDword value;
 
 	if (core->HasFeature(GF_HAS_KAPUTZ) ) {
-		value = CheckVariable(Sender, parameters->string0Parameter, "KAPUTZ");
+		value = CheckVariable(Sender, parameters->GetVariable(0, "KAPUTZ"));
 	} else {
 		ieVariable VariableName;
 		snprintf(VariableName, 32, core->GetDeathVarFormat(), parameters->string0Parameter);
@@ -598,7 +598,7 @@ int GameScript::NumDeadGT(Scriptable* Sender, Trigger* parameters)
 	ieDword value;
 
 	if (core->HasFeature(GF_HAS_KAPUTZ) ) {
-		value = CheckVariable(Sender, parameters->string0Parameter, "KAPUTZ");
+		value = CheckVariable(Sender, parameters->GetVariable(0, "KAPUTZ"));
 	} else {
 		ieVariable VariableName;
 		snprintf(VariableName, 32, core->GetDeathVarFormat(), parameters->string0Parameter);
@@ -612,7 +612,7 @@ int GameScript::NumDeadLT(Scriptable* Sender, Trigger* parameters)
 	ieDword value;
 
 	if (core->HasFeature(GF_HAS_KAPUTZ) ) {
-		value = CheckVariable(Sender, parameters->string0Parameter, "KAPUTZ");
+		value = CheckVariable(Sender, parameters->GetVariable(0, "KAPUTZ"));
 	} else {
 		ieVariable VariableName;
 
@@ -624,7 +624,7 @@ int GameScript::NumDeadLT(Scriptable* Sender, Trigger* parameters)
 
 int GameScript::G_Trigger(Scriptable* Sender, Trigger* parameters)
 {
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL" );
+	ieDwordSigned value = CheckVariable(Sender, parameters->GetVariable(0, "GLOBAL") );
 	return ( value == parameters->int0Parameter );
 }
 
@@ -632,7 +632,7 @@ int GameScript::Global(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDwordSigned value = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		if ( value == parameters->int0Parameter ) return 1;
 	}
@@ -641,7 +641,7 @@ int GameScript::Global(Scriptable* Sender, Trigger* parameters)
 
 int GameScript::GLT_Trigger(Scriptable* Sender, Trigger* parameters)
 {
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter,"GLOBAL" );
+	ieDwordSigned value = CheckVariable(Sender, parameters->GetVariable(0, "GLOBAL") );
 	return ( value < parameters->int0Parameter );
 }
 
@@ -649,7 +649,7 @@ int GameScript::GlobalLT(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDwordSigned value = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		if ( value < parameters->int0Parameter ) return 1;
 	}
@@ -658,7 +658,7 @@ int GameScript::GlobalLT(Scriptable* Sender, Trigger* parameters)
 
 int GameScript::GGT_Trigger(Scriptable* Sender, Trigger* parameters)
 {
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL" );
+	ieDwordSigned value = CheckVariable(Sender, parameters->GetVariable(0, "GLOBAL") );
 	return ( value > parameters->int0Parameter );
 }
 
@@ -666,7 +666,7 @@ int GameScript::GlobalGT(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDwordSigned value = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
 		if ( value > parameters->int0Parameter ) return 1;
 	}
@@ -677,9 +677,9 @@ int GameScript::GlobalLTGlobal(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDwordSigned value1 = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
-		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, &valid );
+		ieDwordSigned value2 = CheckVariable(Sender, parameters->GetVariable(1), &valid );
 		if (valid) {
 			if ( value1 < value2 ) return 1;
 		}
@@ -691,9 +691,9 @@ int GameScript::GlobalGTGlobal(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDwordSigned value1 = CheckVariable(Sender, parameters->string0Parameter, &valid );
+	ieDwordSigned value1 = CheckVariable(Sender, parameters->GetVariable(0), &valid );
 	if (valid) {
-		ieDwordSigned value2 = CheckVariable(Sender, parameters->string1Parameter, &valid );
+		ieDwordSigned value2 = CheckVariable(Sender, parameters->GetVariable(1), &valid );
 		if (valid) {
 			if ( value1 > value2 ) return 1;
 		}
@@ -703,43 +703,43 @@ int GameScript::GlobalGTGlobal(Scriptable* Sender, Trigger* parameters)
 
 int GameScript::GlobalsEqual(Scriptable* Sender, Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL" );
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "GLOBAL" );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, "GLOBAL") );
+	ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1, "GLOBAL") );
 	return ( value1 == value2 );
 }
 
 int GameScript::GlobalsGT(Scriptable* Sender, Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL" );
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "GLOBAL" );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, "GLOBAL") );
+	ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1, "GLOBAL") );
 	return ( value1 > value2 );
 }
 
 int GameScript::GlobalsLT(Scriptable* Sender, Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "GLOBAL" );
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "GLOBAL" );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, "GLOBAL") );
+	ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1, "GLOBAL") );
 	return ( value1 < value2 );
 }
 
 int GameScript::LocalsEqual(Scriptable* Sender, Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "LOCALS" );
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "LOCALS" );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, "LOCALS") );
+	ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1, "LOCALS") );
 	return ( value1 == value2 );
 }
 
 int GameScript::LocalsGT(Scriptable* Sender, Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "LOCALS" );
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "LOCALS" );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, "LOCALS") );
+	ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1, "LOCALS") );
 	return ( value1 > value2 );
 }
 
 int GameScript::LocalsLT(Scriptable* Sender, Trigger* parameters)
 {
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, "LOCALS" );
-	ieDword value2 = CheckVariable(Sender, parameters->string1Parameter, "LOCALS" );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, "LOCALS") );
+	ieDword value2 = CheckVariable(Sender, parameters->GetVariable(1, "LOCALS") );
 	return ( value1 < value2 );
 }
 
@@ -747,7 +747,7 @@ int GameScript::RealGlobalTimerExact(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, parameters->string1Parameter), &valid );
 	if (valid && value1) {
 		ieDword value2 = core->GetGame()->RealTime;
 		if ( value1 == value2 ) return 1;
@@ -759,7 +759,7 @@ int GameScript::RealGlobalTimerExpired(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, parameters->string1Parameter), &valid );
 	if (valid && value1) {
 		if ( value1 < core->GetGame()->RealTime ) return 1;
 	}
@@ -770,7 +770,7 @@ int GameScript::RealGlobalTimerNotExpired(Scriptable* Sender, Trigger* parameter
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, parameters->string1Parameter), &valid );
 	if (valid && value1) {
 		if ( value1 > core->GetGame()->RealTime ) return 1;
 	}
@@ -781,7 +781,7 @@ int GameScript::GlobalTimerExact(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, parameters->string1Parameter), &valid );
 	if (valid) {
 		if ( value1 == core->GetGame()->GameTime ) return 1;
 	}
@@ -792,7 +792,7 @@ int GameScript::GlobalTimerExpired(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, parameters->string1Parameter), &valid );
 	if (valid && (core->HasFeature(GF_ZERO_TIMER_IS_VALID) || value1)) {
 		if ( value1 < core->GetGame()->GameTime ) return 1;
 	}
@@ -804,7 +804,7 @@ int GameScript::GlobalTimerNotExpired(Scriptable* Sender, Trigger* parameters)
 {
 	bool valid=true;
 
-	ieDword value1 = CheckVariable(Sender, parameters->string0Parameter, parameters->string1Parameter, &valid );
+	ieDword value1 = CheckVariable(Sender, parameters->GetVariable(0, parameters->string1Parameter), &valid );
 	if (valid && value1) {
 	 	if ( value1 > core->GetGame()->GameTime ) return 1;
 	}
@@ -3662,7 +3662,7 @@ int GameScript::StuffGlobalRandom( Scriptable* Sender, Trigger* parameters)
 	} else {
 		Value = RandomNumValue;
 	}
-	SetVariable( Sender, parameters->string0Parameter, Value );
+	SetVariable( Sender, parameters->GetVariable(0), Value );
 	if (Value) {
 		return 1;
 	}
@@ -4099,7 +4099,7 @@ int GameScript::SystemVariable_Trigger(Scriptable* Sender, Trigger* parameters)
 		return 0;
 	}
 
-	SetVariable(Sender, parameters->string0Parameter, value);
+	SetVariable(Sender, parameters->GetVariable(0), value);
 	return 1;
 }
 
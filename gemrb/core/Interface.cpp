@@ -43,6 +43,7 @@
 #include "EffectMgr.h"
 #include "EffectQueue.h"
 #include "Factory.h"
+#include "FileCache.h"
 #include "FontManager.h"
 #include "Game.h"
 #include "GameData.h"
@@ -196,6 +197,9 @@ Interface::Interface()
 	TouchScrollAreas = false;
 	UseSoftKeyboard = false;
 	KeepCache = false;
+	VerifyFog = false;
+	VerifySaves = false;
+	BenchmarkMovies = false;
 	NumFingInfo = 2;
 	NumFingKboard = 3;
 	NumFingScroll = 2;
@@ -458,6 +462,7 @@ Interface::~Interface(void)
 	Actor::ReleaseMemory();
 
 	gamedata->ClearCaches();
+	ClearPendingCacheFiles();
 	delete gamedata;
 	gamedata = NULL;
 
@@ -1287,6 +1292,7 @@ int Interface::Init(InterfaceConfig* config)
 			var ( atoi( value ) ); \
 		value = NULL;
 
+	CONFIG_INT("BenchmarkMovies", BenchmarkMovies = );
 	CONFIG_INT("Bpp", Bpp =);
 	vars->SetAt("BitsPerPixel", Bpp); //put into vars so that reading from game.ini wont overwrite
 	CONFIG_INT("CaseSensitive", CaseSensitive =);
@@ -1311,6 +1317,8 @@ int Interface::Init(InterfaceConfig* config)
 	CONFIG_INT("ScriptDebugMode", SetScriptDebugMode);
 	CONFIG_INT("SkipIntroVideos", SkipIntroVideos = );
 	CONFIG_INT("TooltipDelay", TooltipDelay = );
+	CONFIG_INT("VerifyFog", VerifyFog = );
+	CONFIG_INT("VerifySaves", VerifySaves = );
 	CONFIG_INT("Width", Width = );
 	CONFIG_INT("IgnoreOriginalINI", IgnoreOriginalINI = );
 	CONFIG_INT("UseSoftKeyboard", UseSoftKeyboard = );
@@ -1503,6 +1511,10 @@ int Interface::Init(InterfaceConfig* config)
 		char path[_MAX_PATH];
 
 		PathJoin( path, CachePath, NULL);
+		//saved game members not yet inflated into the cache
+		if (IsAvailable( PLUGIN_RESOURCE_SAVEGAME )) {
+			gamedata->AddSource(path, "Saved game", PLUGIN_RESOURCE_SAVEGAME);
+		}
 		if (!gamedata->AddSource(path, "Cache", PLUGIN_RESOURCE_DIRECTORY)) {
 			Log(FATAL, "Core", "The cache path couldn't be registered, please check!");
 			return GEM_ERROR;
@@ -3864,6 +3876,7 @@ void Interface::LoadGame(SaveGame *sg, int ver_override)
 
 	LoadProgress(10);
 	if (!KeepCache) DelTree((const char *) CachePath, true);
+	ClearPendingCacheFiles();
 	LoadProgress(15);
 
 	if (sg == NULL) {
@@ -4488,7 +4501,9 @@ void Interface::RemoveFromCache(const ieResRef resref, SClass_ID ClassID)
 	char filename[_MAX_PATH];
 
 	PathJoinExt(filename, CachePath, resref, TypeExt(ClassID));
+	DropPendingCacheFile(filename);
 	unlink ( filename);
+	ResourceManager::InvalidateLookups();
 }
 
 //this function checks if the path is eligible as a cache
@@ -4553,6 +4568,7 @@ void Interface::DelTree(const char* Pt, bool onlysave)
 			unlink( dtmp );
 		}
 	} while (++dir);
+	ResourceManager::InvalidateLookups();
 }
 
 void Interface::LoadProgress(int percent)
@@ -5271,6 +5287,11 @@ int Interface::WriteWorldMap(const char *folder)
 
 int Interface::CompressSave(const char *folder)
 {
+	//everything has to be in the cache before it is packed
+	if (!ExtractPendingCacheFiles()) {
+		return -1;
+	}
+
 	FileStream str;
 
 	str.Create( folder, GameNameResRef, IE_SAV_CLASS_ID );
@@ -5306,6 +5327,17 @@ int Interface::CompressSave(const char *folder)
 			dir.Rewind();
 		}
 	}
+
+	if (VerifySaves) {
+		//read the new archive back and check it against the cache
+		char path[_MAX_PATH];
+		strlcpy(path, str.originalfile, _MAX_PATH);
+		str.Close();
+		FileStream saved;
+		if (!saved.Open(path) || ai->VerifySaveGame(&saved) != GEM_OK) {
+			Log(ERROR, "Interface", "Saved game \"%s\" doesn't match the cache!", path);
+		}
+	}
 	return 0;
 }
 
@@ -828,6 +828,9 @@ public:
 	int GUIEnhancements;
 	int MaxPartySize;
 	bool KeepCache;
+	bool VerifyFog;
+	bool VerifySaves;
+	bool BenchmarkMovies;
 	bool MultipleQuickSaves;
 	bool UseCorruptedHack;
 	int FeedbackLevel;
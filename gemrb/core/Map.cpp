@@ -66,6 +66,13 @@ namespace GemRB {
 
 #define ANI_PRI_BACKGROUND	-9999
 
+//edge of a proximity cell in pixels; traps have a trigger radius of a few
+//hundred pixels at most, so a query touches only a handful of cells
+#define PROXIMITY_CELL 256
+
+//rasterised sprite covers kept around for reuse
+#define MAX_CACHED_COVERS 32
+
 // TODO: fix this hardcoded resource reference
 static ieResRef PortalResRef={"EF03TPR3"};
 static unsigned int PortalTime = 15;
@@ -109,6 +116,7 @@ void Map::ReleaseMemory()
 	}
 	Spawns.RemoveAll(ReleaseSpawnGroup);
 	PathFinderInited = false;
+	PathNode::ReleaseMemory();
 	if (terrainsounds) {
 		delete [] terrainsounds;
 		terrainsounds = NULL;
@@ -347,6 +355,11 @@ Map::Map(void)
 	//Qcount[PR_IGNORE] = 0;
 	lastActorCount[PR_SCRIPT] = 0;
 	lastActorCount[PR_DISPLAY] = 0;
+	proximityColumns = proximityRows = 0;
+	proximityReach = 0;
+	proximityValid = false;
+	searchMapGeneration = 0;
+	fogPass = 0;
 	//no one needs this
 	//lastActorCount[PR_IGNORE] = 0;
 	if (!PathFinderInited) {
@@ -419,6 +432,10 @@ Map::~Map(void)
 		delete vvc;
 	}
 
+	for (auto &entry : coverCache) {
+		delete entry.cover;
+	}
+
 	for (auto particle : particles) {
 		delete particle;
 	}
@@ -1096,6 +1113,8 @@ void Map::DrawMap(Region screen)
 	}
 	Game *game = core->GetGame();
 	ieDword gametime = game->GameTime;
+	//actors have moved since the last frame
+	proximityValid = false;
 
 	//area specific spawn.ini files (a PST feature)
 	if (INISpawn) {
@@ -1132,7 +1151,12 @@ void Map::DrawMap(Region screen)
 			rain = 0;
 		}
 
-		TMap->DrawOverlays( screen, rain, flags );
+		//tiles under unexplored fog are skipped, since it is drawn over them
+		ieByte* explored = NULL;
+		if ((core->FogOfWar&(FOG_DRAWFOG|FOG_DRAWSEARCHMAP)) == FOG_DRAWFOG) {
+			explored = ExploredBitmap;
+		}
+		TMap->DrawOverlays( screen, rain, flags, explored );
 	}
 
 	//drawing queues 1 and 0
@@ -1486,6 +1510,8 @@ void Map::AddActor(Actor* actor, bool init)
 	strnlwrcpy(actor->Area, scriptName, 8);
 	if (!HasActor(actor)) {
 		actors.push_back( actor );
+		actorIDs[actor->GetGlobalID()] = actor;
+		proximityValid = false;
 	}
 	if (init) {
 		actor->SetMap(this);
@@ -1515,6 +1541,7 @@ void Map::DeleteActor(int i)
 {
 	Actor *actor = actors[i];
 	if (actor) {
+		actorIDs.erase(actor->GetGlobalID());
 		Game *game = core->GetGame();
 		//this makes sure that a PC will be demoted to NPC
 		game->LeaveParty( actor );
@@ -1531,6 +1558,7 @@ void Map::DeleteActor(int i)
 	}
 	//remove the actor from the area's actor list
 	actors.erase( actors.begin()+i );
+	proximityValid = false;
 }
 
 Scriptable *Map::GetScriptableByGlobalID(ieDword objectID)
@@ -1563,41 +1591,34 @@ Door *Map::GetDoorByGlobalID(ieDword objectID)
 {
 	if (!objectID) return NULL;
 
-	int doorCount = 0;
-	while (true) {
-		Door* door = TMap->GetDoor( doorCount++ );
-		if (!door)
-			return NULL;
-		if (door->GetGlobalID() == objectID)
-			return door;
-	}
+	Scriptable *scr = TMap->GetScriptableByGlobalID(objectID);
+	if (scr && scr->Type == ST_DOOR)
+		return (Door *) scr;
+	return NULL;
 }
 
 Container *Map::GetContainerByGlobalID(ieDword objectID)
 {
 	if (!objectID) return NULL;
 
-	int containerCount = 0;
-	while (true) {
-		Container* container = TMap->GetContainer( containerCount++ );
-		if (!container)
-			return NULL;
-		if (container->GetGlobalID() == objectID)
-			return container;
-	}
+	Scriptable *scr = TMap->GetScriptableByGlobalID(objectID);
+	if (scr && scr->Type == ST_CONTAINER)
+		return (Container *) scr;
+	return NULL;
 }
 
 InfoPoint *Map::GetInfoPointByGlobalID(ieDword objectID)
 {
 	if (!objectID) return NULL;
 
-	int ipCount = 0;
-	while (true) {
-		InfoPoint* ip = TMap->GetInfoPoint( ipCount++ );
-		if (!ip)
+	Scriptable *scr = TMap->GetScriptableByGlobalID(objectID);
+	if (!scr)
+		return NULL;
+	switch (scr->Type) {
+		case ST_PROXIMITY: case ST_TRIGGER: case ST_TRAVEL:
+			return (InfoPoint *) scr;
+		default:
 			return NULL;
-		if (ip->GetGlobalID() == objectID)
-			return ip;
 	}
 }
 
@@ -1606,12 +1627,11 @@ Actor* Map::GetActorByGlobalID(ieDword objectID)
 	if (!objectID) {
 		return NULL;
 	}
-	for (auto actor : actors) {
-		if (actor->GetGlobalID()==objectID) {
-			return actor;
-		}
+	std::map<ieDword, Actor*>::const_iterator it = actorIDs.find(objectID);
+	if (it == actorIDs.end()) {
+		return NULL;
 	}
-	return NULL;
+	return it->second;
 }
 
 /** flags:
@@ -1646,6 +1666,60 @@ Actor* Map::GetActorInRadius(const Point &p, int flags, unsigned int radius)
 	return NULL;
 }
 
+void Map::BuildProximityCells()
+{
+	Point size = TMap->GetMapSize();
+	proximityColumns = size.x/PROXIMITY_CELL + 1;
+	proximityRows = size.y/PROXIMITY_CELL + 1;
+	proximityCells.resize(proximityColumns*proximityRows);
+	for (auto &cell : proximityCells) {
+		cell.clear();
+	}
+
+	//actors outside the map are clamped into the border cells, which keeps
+	//them reachable for queries reaching past the map edge
+	proximityReach = 0;
+	for (auto actor : actors) {
+		int x = Clamp(actor->Pos.x/PROXIMITY_CELL, 0, proximityColumns-1);
+		int y = Clamp(actor->Pos.y/PROXIMITY_CELL, 0, proximityRows-1);
+		proximityCells[y*proximityColumns+x].push_back(actor);
+		if (actor->size*10 > proximityReach) {
+			proximityReach = actor->size*10;
+		}
+	}
+	proximityValid = true;
+}
+
+bool Map::AnyActorInRadius(const Point &p, int flags, unsigned int radius)
+{
+	if (!TMap) {
+		return GetActorInRadius(p, flags, radius) != NULL;
+	}
+	if (!proximityValid) {
+		BuildProximityCells();
+	}
+
+	//PersonalDistance subtracts the actor size, so look that much further
+	int reach = (int) radius + proximityReach;
+	int x1 = Clamp((p.x-reach)/PROXIMITY_CELL, 0, proximityColumns-1);
+	int x2 = Clamp((p.x+reach)/PROXIMITY_CELL, 0, proximityColumns-1);
+	int y1 = Clamp((p.y-reach)/PROXIMITY_CELL, 0, proximityRows-1);
+	int y2 = Clamp((p.y+reach)/PROXIMITY_CELL, 0, proximityRows-1);
+	for (int y = y1; y <= y2; y++) {
+		for (int x = x1; x <= x2; x++) {
+			for (auto actor : proximityCells[y*proximityColumns+x]) {
+				if (PersonalDistance( p, actor ) > radius)
+					continue;
+				if (!actor->ValidTarget(flags) ) {
+					continue;
+				}
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 std::vector<Actor *> Map::GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, const Scriptable *see) const
 {
 	std::vector<Actor *> neighbours;
@@ -1994,6 +2068,22 @@ unsigned int Map::GetBlocked(const Point &c) const
 SpriteCover* Map::BuildSpriteCover(int x, int y, int xpos, int ypos,
 	unsigned int width, unsigned int height, int flags, bool areaanim)
 {
+	//only the wall polygons reaching into the sprite rectangle matter
+	//(grown by a pixel, as polygon bounding boxes exclude their far edge)
+	Region rect(x - xpos - 1, y - ypos - 1, width + 2, height + 2);
+	std::vector<unsigned int> walls;
+	unsigned int wpcount = GetWallCount();
+	for (unsigned int i = 0; i < wpcount; ++i)
+	{
+		Wall_Polygon* wp = GetWallGroup(i);
+		if (!wp) continue;
+		if (!wp->BBox.IntersectsRegion(rect)) continue;
+		if (!wp->PointCovered(x, y)) continue;
+		if (areaanim && !(wp->GetPolygonFlag() & WF_COVERANIMS)) continue;
+
+		walls.push_back(i);
+	}
+
 	SpriteCover* sc = new SpriteCover;
 	sc->worldx = x;
 	sc->worldy = y;
@@ -2003,27 +2093,77 @@ SpriteCover* Map::BuildSpriteCover(int x, int y, int xpos, int ypos,
 	sc->Height = height;
 
 	Video* video = core->GetVideoDriver();
-	video->InitSpriteCover(sc, flags);
-
-	unsigned int wpcount = GetWallCount();
-	for (unsigned int i = 0; i < wpcount; ++i)
-	{
-		Wall_Polygon* wp = GetWallGroup(i);
-		if (!wp) continue;
-		if (!wp->PointCovered(x, y)) continue;
-		if (areaanim && !(wp->GetPolygonFlag() & WF_COVERANIMS)) continue;
-
-		video->AddPolygonToSpriteCover(sc, wp);
+	if (walls.empty()) {
+		video->InitSpriteCover(sc, flags);
+		return sc;
+	}
+
+	//reuse an earlier cover built from the same polygons at this spot
+	//it may be larger than requested, which is fine for the blitters
+	std::list<CachedCover>::iterator it;
+	for (it = coverCache.begin(); it != coverCache.end(); ++it) {
+		SpriteCover *cached = it->cover;
+		if (cached->flags != flags) continue;
+		if (!cached->Covers(x, y, xpos, ypos, width, height)) continue;
+		if (it->walls != walls) continue;
+
+		sc->XPos = cached->XPos;
+		sc->YPos = cached->YPos;
+		sc->Width = cached->Width;
+		sc->Height = cached->Height;
+		video->InitSpriteCover(sc, flags);
+		memcpy(sc->pixels, cached->pixels, sc->Width*sc->Height);
+		coverCache.splice(coverCache.begin(), coverCache, it);
+		return sc;
 	}
 
+	video->InitSpriteCover(sc, flags);
+	for (auto i : walls) {
+		video->AddPolygonToSpriteCover(sc, GetWallGroup(i));
+	}
+
+	CachedCover entry;
+	entry.cover = new SpriteCover;
+	*entry.cover = *sc;
+	entry.cover->pixels = NULL;
+	video->InitSpriteCover(entry.cover, flags);
+	memcpy(entry.cover->pixels, sc->pixels, sc->Width*sc->Height);
+	entry.walls.swap(walls);
+	coverCache.push_front(entry);
+	if (coverCache.size() > MAX_CACHED_COVERS) {
+		delete coverCache.back().cover;
+		coverCache.pop_back();
+	}
 	return sc;
 }
 
+//drops the cached covers built with any of the given wall polygons
+void Map::PurgeCoverCache(unsigned int baseindex, unsigned int count)
+{
+	std::list<CachedCover>::iterator it = coverCache.begin();
+	while (it != coverCache.end()) {
+		bool used = false;
+		for (auto i : it->walls) {
+			if (i >= baseindex && i < baseindex + count) {
+				used = true;
+				break;
+			}
+		}
+		if (used) {
+			delete it->cover;
+			it = coverCache.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
 void Map::ActivateWallgroups(unsigned int baseindex, unsigned int count, int flg)
 {
 	if (!Walls) {
 		return;
 	}
+	bool changed = false;
 	for (unsigned int i = baseindex; i < baseindex + count; ++i) {
 		Wall_Polygon* wp = GetWallGroup(i);
 		if (!wp)
@@ -2033,11 +2173,28 @@ void Map::ActivateWallgroups(unsigned int baseindex, unsigned int count, int flg
 			value&=~WF_DISABLED;
 		else
 			value|=WF_DISABLED;
-		wp->SetPolygonFlag(value);
+		if (value != wp->GetPolygonFlag()) {
+			wp->SetPolygonFlag(value);
+			changed = true;
+		}
+	}
+	if (!changed) {
+		return;
 	}
-	//all actors will have to generate a new spritecover
+	PurgeCoverCache(baseindex, count);
+
+	//actors overlapping the toggled polygons will have to generate a new spritecover
 	for (auto actor : actors) {
-		actor->SetSpriteCover(NULL);
+		SpriteCover *sc = actor->GetSpriteCover();
+		if (!sc) continue;
+		Region rect(sc->worldx - sc->XPos - 1, sc->worldy - sc->YPos - 1, sc->Width + 2, sc->Height + 2);
+		for (unsigned int i = baseindex; i < baseindex + count; ++i) {
+			Wall_Polygon* wp = GetWallGroup(i);
+			if (wp && wp->BBox.IntersectsRegion(rect)) {
+				actor->SetSpriteCover(NULL);
+				break;
+			}
+		}
 	}
 }
 
@@ -2257,12 +2414,8 @@ Entrance* Map::GetEntrance(const char* Name)
 
 bool Map::HasActor(Actor *actor)
 {
-	for (Actor *act : actors) {
-		if (act == actor) {
-			return true;
-		}
-	}
-	return false;
+	std::map<ieDword, Actor*>::const_iterator it = actorIDs.find(actor->GetGlobalID());
+	return it != actorIDs.end() && it->second == actor;
 }
 
 void Map::RemoveActor(Actor* actor)
@@ -2276,6 +2429,8 @@ void Map::RemoveActor(Actor* actor)
 			actor->SetMap(NULL);
 			CopyResRef(actor->Area, "");
 			actors.erase( actors.begin()+i );
+			actorIDs.erase(actor->GetGlobalID());
+			proximityValid = false;
 			return;
 		}
 	}
@@ -2361,6 +2516,52 @@ void Map::Leveldown(unsigned int px, unsigned int py,
 	}
 }
 
+//PathNode pool, free nodes are chained through their first word
+#define PATHNODE_BLOCK 512
+
+static std::vector<PathNode*> PathNodeBlocks;
+static void* FreePathNodes = NULL;
+static size_t PathNodesInUse = 0;
+
+void* PathNode::operator new(size_t size)
+{
+	assert(size == sizeof(PathNode));
+	if (!FreePathNodes) {
+		PathNode *block = (PathNode *) malloc(PATHNODE_BLOCK * sizeof(PathNode));
+		PathNodeBlocks.push_back(block);
+		for (int i = PATHNODE_BLOCK - 1; i >= 0; i--) {
+			*(void **) (block + i) = FreePathNodes;
+			FreePathNodes = block + i;
+		}
+	}
+	void *node = FreePathNodes;
+	FreePathNodes = *(void **) node;
+	PathNodesInUse++;
+	return node;
+}
+
+void PathNode::operator delete(void* ptr)
+{
+	if (!ptr) {
+		return;
+	}
+	*(void **) ptr = FreePathNodes;
+	FreePathNodes = ptr;
+	PathNodesInUse--;
+}
+
+void PathNode::ReleaseMemory()
+{
+	if (PathNodesInUse) {
+		return;
+	}
+	for (auto block : PathNodeBlocks) {
+		free(block);
+	}
+	PathNodeBlocks.clear();
+	FreePathNodes = NULL;
+}
+
 void Map::SetupNode(unsigned int x, unsigned int y, unsigned int size, unsigned int Cost)
 {
 	unsigned int pos;
@@ -3298,19 +3499,28 @@ void Map::SetMapVisibility(int setreset)
 }
 
 // x, y are not in tile coordinates
-void Map::ExploreTile(const Point &pos)
+// returns the index of the fog bit covering pos, or -1 if it is off the map
+int Map::GetFogBit(const Point &pos) const
 {
 	int h = TMap->YCellCount * 2 + LargeFog;
 	int y = pos.y/32;
 	if (y < 0 || y >= h)
-		return;
+		return -1;
 
 	int w = TMap->XCellCount * 2 + LargeFog;
 	int x = pos.x/32;
 	if (x < 0 || x >= w)
+		return -1;
+
+	return (y * w) + x;
+}
+
+void Map::ExploreTile(const Point &pos)
+{
+	int b0 = GetFogBit(pos);
+	if (b0 < 0)
 		return;
 
-	int b0 = (y * w) + x;
 	int by = b0/8;
 	int bi = 1<<(b0%8);
 
@@ -3319,6 +3529,12 @@ void Map::ExploreTile(const Point &pos)
 }
 
 void Map::ExploreMapChunk(const Point &Pos, int range, int los)
+{
+	ExploreMapChunk(Pos, range, los, NULL);
+}
+
+//if footprint is given, the fog bits are collected there instead of being set
+void Map::ExploreMapChunk(const Point &Pos, int range, int los, std::vector<unsigned int> *footprint)
 {
 	Point Tile;
 
@@ -3351,7 +3567,14 @@ void Map::ExploreMapChunk(const Point &Pos, int range, int los)
 					if (!Pass) break;
 				}
 			}
-			ExploreTile(Tile);
+			if (footprint) {
+				int b0 = GetFogBit(Tile);
+				if (b0 >= 0) {
+					footprint->push_back(b0);
+				}
+			} else {
+				ExploreTile(Tile);
+			}
 		}
 	}
 }
@@ -3365,6 +3588,7 @@ void Map::UpdateFog()
 		SetMapVisibility( 0 );
 	}
 
+	fogPass++;
 	for (auto actor : actors) {
 		if (!actor->Modified[ IE_EXPLORE ] ) continue;
 		if (core->FogOfWar&FOG_DRAWFOG) {
@@ -3372,13 +3596,57 @@ void Map::UpdateFog()
 			if (state & STATE_CANTSEE) continue;
 			int vis2 = actor->Modified[IE_VISUALRANGE];
 			if ((state&STATE_BLIND) || (vis2<2)) vis2=2; //can see only themselves
-			ExploreMapChunk (actor->Pos, vis2+actor->GetAnims()->GetCircleSize(), 1);
+			int range = vis2+actor->GetAnims()->GetCircleSize();
+
+			//only cast the vision rays again if the actor moved, its vision
+			//changed or a door changed the line of sight
+			FogFootprint &fp = fogFootprints[actor->GetGlobalID()];
+			if (fp.pos != actor->Pos || fp.range != range || fp.generation != searchMapGeneration) {
+				fp.pos = actor->Pos;
+				fp.range = range;
+				fp.generation = searchMapGeneration;
+				fp.bits.clear();
+				ExploreMapChunk(actor->Pos, range, 1, &fp.bits);
+				std::sort(fp.bits.begin(), fp.bits.end());
+				fp.bits.erase(std::unique(fp.bits.begin(), fp.bits.end()), fp.bits.end());
+			}
+			fp.pass = fogPass;
+			for (auto b0 : fp.bits) {
+				int by = b0/8;
+				int bi = 1<<(b0%8);
+				ExploredBitmap[by] |= bi;
+				VisibleBitmap[by] |= bi;
+			}
 		}
 		Spawn *sp = GetSpawnRadius(actor->Pos, SPAWN_RANGE); //30 * 12
 		if (sp) {
 			TriggerSpawn(sp);
 		}
 	}
+
+	//forget the actors that left or stopped exploring
+	std::map<ieDword, FogFootprint>::iterator it = fogFootprints.begin();
+	while (it != fogFootprints.end()) {
+		if (it->second.pass != fogPass) {
+			fogFootprints.erase(it++);
+		} else {
+			++it;
+		}
+	}
+
+	if (core->VerifyFog && (core->FogOfWar&FOG_DRAWFOG)) {
+		//cast all the vision rays again and compare with the cached result
+		unsigned int size = GetExploredMapSize();
+		std::vector<ieByte> explored(ExploredBitmap, ExploredBitmap+size);
+		std::vector<ieByte> visible(VisibleBitmap, VisibleBitmap+size);
+		SetMapVisibility( 0 );
+		for (it = fogFootprints.begin(); it != fogFootprints.end(); ++it) {
+			ExploreMapChunk(it->second.pos, it->second.range, 1, NULL);
+		}
+		if (memcmp(&explored[0], ExploredBitmap, size) || memcmp(&visible[0], VisibleBitmap, size)) {
+			Log(ERROR, "Map", "%s: cached fog of war differs from the full recalculation!", scriptName);
+		}
+	}
 }
 
 //Valid values are - PATH_MAP_FREE, PATH_MAP_PC, PATH_MAP_NPC
@@ -4067,6 +4335,7 @@ void Map::SetInternalSearchMap(int x, int y, int value)
 		return;
 	}
 	SrchMap[x+y*Width] = value;
+	searchMapGeneration++;
 }
 
 void Map::SetBackground(const ieResRef &bgResRef, ieDword duration)
@@ -28,6 +28,7 @@
 #include "Scriptable/Scriptable.h"
 
 #include <algorithm>
+#include <map>
 #include <queue>
 
 namespace GemRB {
@@ -314,6 +315,24 @@ enum AnimationObjectType {AOT_AREA, AOT_SCRIPTED, AOT_ACTOR, AOT_SPARK, AOT_PROJ
 #define PR_DISPLAY 1
 #define PR_IGNORE  2
 
+//a rasterised sprite cover kept for reuse, along with the wall polygons
+//that went into it
+struct CachedCover {
+	SpriteCover *cover;
+	std::vector<unsigned int> walls;
+};
+
+//fog of war bits revealed by an actor, reused while it stands still
+struct FogFootprint {
+	Point pos;
+	int range;
+	unsigned int generation;
+	unsigned int pass;
+	std::vector<unsigned int> bits;
+
+	FogFootprint() : range(0), generation(0), pass(0) {}
+};
+
 typedef std::list<AreaAnimation*>::iterator aniIterator;
 typedef std::list<VEFObject*>::iterator scaIterator;
 typedef std::list<Projectile*>::iterator proIterator;
@@ -354,6 +373,7 @@ private:
 	unsigned int Width, Height;
 	std::list< AreaAnimation*> animations;
 	std::vector< Actor*> actors;
+	std::map<ieDword, Actor*> actorIDs;
 	Wall_Polygon **Walls;
 	unsigned int WallCount;
 	std::list< VEFObject*> vvcCells;
@@ -366,6 +386,18 @@ private:
 	Actor** queue[QUEUE_COUNT];
 	int Qcount[QUEUE_COUNT];
 	unsigned int lastActorCount[QUEUE_COUNT];
+	//actors bucketed by position, rebuilt at most once per frame for the
+	//proximity checks of armed traps
+	std::vector< std::vector<Actor*> > proximityCells;
+	int proximityColumns, proximityRows;
+	int proximityReach;
+	bool proximityValid;
+	std::list<CachedCover> coverCache;
+	//vision of the explore actors, keyed by global ID
+	std::map<ieDword, FogFootprint> fogFootprints;
+	//bumped when the line of sight blockers of the searchmap change
+	unsigned int searchMapGeneration;
+	unsigned int fogPass;
 public:
 	Map(void);
 	~Map(void);
@@ -437,6 +469,8 @@ public:
 	Actor* GetActorByGlobalID(ieDword objectID);
 	Actor* GetActor(const Point &p, int flags);
 	Actor* GetActorInRadius(const Point &p, int flags, unsigned int radius);
+	//like GetActorInRadius, but only looks at the actors near p
+	bool AnyActorInRadius(const Point &p, int flags, unsigned int radius);
 	std::vector<Actor *> GetAllActorsInRadius(const Point &p, int flags, unsigned int radius, const Scriptable *see = NULL) const;
 	Actor* GetActor(const char* Name, int flags);
 	Actor* GetActor(int i, bool any) const;
@@ -598,6 +632,10 @@ private:
 	void SortQueues();
 	//Actor* GetRoot(int priority, int &index);
 	void DeleteActor(int i);
+	void BuildProximityCells();
+	int GetFogBit(const Point &pos) const;
+	void ExploreMapChunk(const Point &Pos, int range, int los, std::vector<unsigned int> *footprint);
+	void PurgeCoverCache(unsigned int baseindex, unsigned int count);
 	void Leveldown(unsigned int px, unsigned int py, unsigned int& level,
 		Point &p, unsigned int& diff);
 	void SetupNode(unsigned int x, unsigned int y, unsigned int size, unsigned int Cost);
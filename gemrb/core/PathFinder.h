@@ -20,6 +20,10 @@
 #ifndef PATHFINDER_H
 #define PATHFINDER_H
 
+#include "exports.h"
+
+#include <cstddef>
+
 namespace GemRB {
 
 //searchmap conversion bits
@@ -43,12 +47,19 @@ enum {
 	PATH_MAP_NOTACTOR = (PATH_MAP_DOOR|PATH_MAP_AREAMASK)
 };
 
-struct PathNode {
+struct GEM_EXPORT PathNode {
 	PathNode* Parent;
 	PathNode* Next;
 	unsigned short x;
 	unsigned short y;
 	unsigned int orient;
+
+	//paths are rebuilt too often for a heap allocation per step,
+	//so the nodes are carved from pooled blocks (see Map.cpp)
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr);
+	//frees the pooled blocks once no node is in use
+	static void ReleaseMemory();
 };
 
 }
@@ -1092,7 +1092,7 @@ void Projectile::CheckTrigger(unsigned int radius)
 			}
 		}
 	}
-	if (area->GetActorInRadius(Pos, CalculateTargetFlag(), radius)) {
+	if (area->AnyActorInRadius(Pos, CalculateTargetFlag(), radius)) {
 		if (phase == P_TRIGGER) {
 			phase = P_EXPLODING1;
 			extension_delay = Extension->Delay;
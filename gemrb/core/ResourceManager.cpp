@@ -25,17 +25,29 @@
 #include "Resource.h"
 #include "ResourceDesc.h"
 #include "ResourceSource.h"
+#include "System/DataStream.h"
 #include "System/StringBuffer.h"
 
 namespace GemRB {
 
+#define LOOKUP_UNKNOWN -2
+#define LOOKUP_MISSING -1
+
+//bumped whenever a file is written, see InvalidateLookups
+static unsigned int LookupGeneration = 0;
+
 ResourceManager::ResourceManager()
 {
+	lookupGeneration = LookupGeneration;
+	lookupHits = lookupMisses = 0;
 }
 
 
 ResourceManager::~ResourceManager()
 {
+	if (lookupHits || lookupMisses) {
+		Log(DEBUG, "ResourceManager", "Lookup cache: %u hits, %u misses.", lookupHits, lookupMisses);
+	}
 }
 
 bool ResourceManager::AddSource(const char *path, const char *description, PluginID type, int flags)
@@ -56,9 +68,66 @@ bool ResourceManager::AddSource(const char *path, const char *description, Plugi
 	} else {
 		searchPath.push_back(source);
 	}
+	lookups.clear();
 	return true;
 }
 
+//only FileStream::Create, RemoveFromCache, DelTree and AddPendingCacheFile
+//call this, files changed outside of the engine are not noticed
+void ResourceManager::InvalidateLookups()
+{
+	LookupGeneration++;
+}
+
+ResourceManager::LookupKey::LookupKey(const char *ResRef, const char *ext)
+{
+	size_t len = 0;
+	valid = false;
+	for (const char *c = ResRef; *c; c++) {
+		if (len >= sizeof(name) - 1) return;
+		name[len++] = tolower(*c);
+	}
+	if (len >= sizeof(name) - 1) return;
+	name[len++] = '.';
+	for (const char *c = ext ? ext : ""; *c; c++) {
+		if (len >= sizeof(name) - 1) return;
+		name[len++] = tolower(*c);
+	}
+	name[len] = 0;
+	valid = true;
+}
+
+bool ResourceManager::LookupKey::operator<(const LookupKey &other) const
+{
+	return strcmp(name, other.name) < 0;
+}
+
+int ResourceManager::LookupSource(const LookupKey &key) const
+{
+	if (!key.valid) {
+		return LOOKUP_UNKNOWN;
+	}
+	if (lookupGeneration != LookupGeneration) {
+		lookups.clear();
+		lookupGeneration = LookupGeneration;
+	}
+
+	std::map<LookupKey, int>::const_iterator it = lookups.find(key);
+	if (it == lookups.end()) {
+		lookupMisses++;
+		return LOOKUP_UNKNOWN;
+	}
+	lookupHits++;
+	return it->second;
+}
+
+void ResourceManager::StoreLookup(const LookupKey &key, int source) const
+{
+	if (key.valid) {
+		lookups[key] = source;
+	}
+}
+
 static void PrintPossibleFiles(StringBuffer& buffer, const char* ResRef, const TypeID *type)
 {
 	const std::vector<ResourceDesc>& types = PluginMgr::Get()->GetResourceDesc(type);
@@ -71,11 +140,20 @@ bool ResourceManager::Exists(const char *ResRef, SClass_ID type, bool silent) co
 {
 	if (ResRef[0] == '\0')
 		return false;
-	// TODO: check various caches
-	for (size_t i = 0; i < searchPath.size(); i++) {
-		if (searchPath[i]->HasResource( ResRef, type )) {
-			return true;
+	const char *ext = core->TypeExt(type);
+	LookupKey key(ResRef, ext);
+	int source = LookupSource(key);
+	if (source >= 0) {
+		return true;
+	}
+	if (source == LOOKUP_UNKNOWN) {
+		for (size_t i = 0; i < searchPath.size(); i++) {
+			if (searchPath[i]->HasResource( ResRef, type )) {
+				StoreLookup(key, i);
+				return true;
+			}
 		}
+		StoreLookup(key, LOOKUP_MISSING);
 	}
 	if (!silent) {
 		Log(WARNING, "ResourceManager", "'%s.%s' not found...",
@@ -88,14 +166,23 @@ bool ResourceManager::Exists(const char *ResRef, const TypeID *type, bool silent
 {
 	if (ResRef[0] == '\0')
 		return false;
-	// TODO: check various caches
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (size_t j = 0; j < types.size(); j++) {
+		LookupKey key(ResRef, types[j].GetExt());
+		int source = LookupSource(key);
+		if (source >= 0) {
+			return true;
+		}
+		if (source == LOOKUP_MISSING) {
+			continue;
+		}
 		for (size_t i = 0; i < searchPath.size(); i++) {
 			if (searchPath[i]->HasResource(ResRef, types[j])) {
+				StoreLookup(key, i);
 				return true;
 			}
 		}
+		StoreLookup(key, LOOKUP_MISSING);
 	}
 	if (!silent) {
 		StringBuffer buffer;
@@ -111,16 +198,28 @@ DataStream* ResourceManager::GetResource(const char* ResRef, SClass_ID type, boo
 {
 	if (ResRef[0] == '\0')
 		return NULL;
-	for (size_t i = 0; i < searchPath.size(); i++) {
+	const char *ext = core->TypeExt(type);
+	LookupKey key(ResRef, ext);
+	int source = LookupSource(key);
+	if (source == LOOKUP_MISSING) {
+		if (!silent) {
+			Log(ERROR, "ResourceManager", "Couldn't find '%s.%s'.", ResRef, ext);
+		}
+		return NULL;
+	}
+	//the file may have vanished since, then search again
+	for (size_t i = source >= 0 ? source : 0; i < searchPath.size(); i++) {
 		DataStream *ds = searchPath[i]->GetResource(ResRef, type);
 		if (ds) {
 			if (!silent) {
 				Log(MESSAGE, "ResourceManager", "Found '%s.%s' in '%s'.",
-					ResRef, core->TypeExt(type), searchPath[i]->GetDescription());
+					ResRef, ext, searchPath[i]->GetDescription());
 			}
+			StoreLookup(key, i);
 			return ds;
 		}
 	}
+	StoreLookup(key, LOOKUP_MISSING);
 	if (!silent) {
 		Log(ERROR, "ResourceManager", "Couldn't find '%s.%s'.",
 			ResRef, core->TypeExt(type));
@@ -137,6 +236,11 @@ Resource* ResourceManager::GetResource(const char* ResRef, const TypeID *type, b
 	}
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (size_t j = 0; j < types.size(); j++) {
+		LookupKey key(ResRef, types[j].GetExt());
+		if (LookupSource(key) == LOOKUP_MISSING) {
+			continue;
+		}
+		bool found = false;
 		for (size_t i = 0; i < searchPath.size(); i++) {
 			DataStream *str = searchPath[i]->GetResource(ResRef, types[j]);
 			if (!str && useCorrupt && core->UseCorruptedHack) {
@@ -146,6 +250,7 @@ Resource* ResourceManager::GetResource(const char* ResRef, const TypeID *type, b
 			}
 			core->UseCorruptedHack = false;
 			if (str) {
+				found = true;
 				Resource *res = types[j].Create(str);
 				if (res) {
 					if (!silent) {
@@ -156,6 +261,9 @@ Resource* ResourceManager::GetResource(const char* ResRef, const TypeID *type, b
 				}
 			}
 		}
+		if (!found) {
+			StoreLookup(key, LOOKUP_MISSING);
+		}
 	}
 	if (!silent) {
 		StringBuffer buffer;
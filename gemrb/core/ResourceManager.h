@@ -23,9 +23,12 @@
 
 #include "SClassID.h"
 #include "exports.h"
+#include "ie_types.h"
 
 #include "Holder.h"
 
+#include <map>
+#include <string>
 #include <vector>
 
 #if defined(_MSC_VER) || defined(__sgi) // No SFINAE
@@ -67,8 +70,35 @@ public:
 	/** Returns Resource object associated to given resource */
 	Resource* GetResource(const char* resname, const TypeID *type, bool silent = false, bool useCorrupt = false) const;
 
+	/**
+	 * Forgets where resources were found and which ones are missing.
+	 * Called when files get written, since a new file can shadow
+	 * or provide any resource.
+	 **/
+	static void InvalidateLookups();
+
 private:
+	/** lowercase "resref.ext", unusable (and not cached) if too long */
+	struct LookupKey {
+		LookupKey(const char *ResRef, const char *ext);
+		bool operator<(const LookupKey &other) const;
+
+		char name[24];
+		bool valid;
+	};
+
+	/** index of the source holding the resource, -1 if none, -2 if unknown */
+	int LookupSource(const LookupKey &key) const;
+	void StoreLookup(const LookupKey &key, int source) const;
+
 	std::vector<Holder<ResourceSource> > searchPath;
+
+	//resolved lookups; they are only invalidated by files the engine
+	//writes itself, so override files changed behind its back are
+	//not noticed until the next start
+	mutable std::map<LookupKey, int> lookups;
+	mutable unsigned int lookupGeneration;
+	mutable unsigned int lookupHits, lookupMisses;
 };
 
 }
@@ -282,6 +282,26 @@ static bool IsSaveGameSlot(const char* Path, const char* slotname)
 	return true;
 }
 
+/*
+ * Fills in the modification times of the slot directory and its preview,
+ * a saved game rewrites the preview even if no file is added or removed.
+ */
+static bool GetSlotStamp(const char* Path, const char* slotname, struct stat &dirStat, struct stat &previewStat)
+{
+	char dtmp[_MAX_PATH];
+	PathJoin(dtmp, Path, slotname, NULL);
+	if (stat(dtmp, &dirStat)) {
+		return false;
+	}
+
+	char ftmp[_MAX_PATH];
+	PathJoinExt(ftmp, dtmp, core->GameNameResRef, "bmp");
+	if (stat(ftmp, &previewStat)) {
+		return false;
+	}
+	return true;
+}
+
 bool SaveGameIterator::RescanSaveGames()
 {
 	// delete old entries
@@ -300,21 +320,46 @@ bool SaveGameIterator::RescanSaveGames()
 		dir.Rewind();
 	}
 	if (!dir) { //If we cannot open the Directory
+		slotCache.clear();
 		return false;
 	}
 
 	std::set<char*,iless> slots;
 	do {
 		const char *name = dir.GetName();
-		if (dir.IsDirectory() && IsSaveGameSlot( Path, name )) {
+		if (name[0] != '.' && dir.IsDirectory()) {
 			slots.insert(strdup(name));
 		}
 	} while (++dir);
 
+	// only check and build the slots that changed since the last scan
+	std::map<std::string, CachedSlot> seen;
 	for (std::set<char*,iless>::iterator i = slots.begin(); i != slots.end(); ++i) {
-		save_slots.push_back(BuildSaveGame(*i));
+		struct stat dirStat, previewStat;
+		bool stamped = GetSlotStamp(Path, *i, dirStat, previewStat);
+
+		std::map<std::string, CachedSlot>::iterator cached = slotCache.find(*i);
+		if (stamped && cached != slotCache.end()
+			&& cached->second.dirTime == dirStat.st_mtime
+			&& cached->second.previewTime == previewStat.st_mtime
+			&& cached->second.previewSize == previewStat.st_size) {
+			save_slots.push_back(cached->second.save);
+			seen[*i] = cached->second;
+		} else if (IsSaveGameSlot(Path, *i)) {
+			Holder<SaveGame> save = BuildSaveGame(*i);
+			save_slots.push_back(save);
+			if (stamped && save) {
+				CachedSlot &slot = seen[*i];
+				slot.dirTime = dirStat.st_mtime;
+				slot.previewTime = previewStat.st_mtime;
+				slot.previewSize = previewStat.st_size;
+				slot.save = save;
+			}
+		}
 		free(*i);
 	}
+	// drops the slots that are gone
+	slotCache.swap(seen);
 
 	return true;
 }
@@ -404,6 +449,8 @@ void SaveGameIterator::PruneQuickSave(const char *folder)
 		rmdir(from);
 	}
 	//shift paths, always do this, because they are aging
+	//renaming keeps the times, so the cached slots can't be trusted
+	slotCache.clear();
 	size = myslots.size();
 	for(i=size;i--;) {
 		FormatQuickSavePath(from, myslots[i]);
@@ -701,6 +748,7 @@ void SaveGameIterator::DeleteSaveGame(Holder<SaveGame> game)
 
 	core->DelTree( game->GetPath(), false ); //remove all files from folder
 	rmdir( game->GetPath() );
+	slotCache.erase(game->GetSlotName());
 }
 
 }
@@ -25,6 +25,8 @@
 
 #include "SaveGame.h"
 
+#include <map>
+#include <string>
 #include <vector>
 
 namespace GemRB {
@@ -36,6 +38,15 @@ private:
 	typedef std::vector<Holder<SaveGame> > charlist;
 	charlist save_slots;
 
+	//the slots found by earlier scans, reused while their files don't change
+	struct CachedSlot {
+		time_t dirTime;
+		time_t previewTime;
+		off_t previewSize;
+		Holder<SaveGame> save;
+	};
+	std::map<std::string, CachedSlot> slotCache;
+
 public:
 	SaveGameIterator(void);
 	~SaveGameIterator(void);
@@ -467,6 +467,8 @@ Actor::Actor()
 	WeaponRef[0]=0;
 	for (i = 0; i < EXTRA_ACTORCOVERS; ++i)
 		extraCovers[i] = NULL;
+	for (i = 0; i < PIN_COUNT; ++i)
+		pinnedItems[i] = NULL;
 
 	LongName = NULL;
 	ShortName = NULL;
@@ -586,6 +588,11 @@ Actor::~Actor(void)
 	}
 	for (i = 0; i < EXTRA_ACTORCOVERS; i++)
 		delete extraCovers[i];
+	for (i = 0; i < PIN_COUNT; i++) {
+		if (pinnedItems[i] && gamedata) {
+			gamedata->FreeItem(pinnedItems[i], pinnedItems[i]->Name, false);
+		}
+	}
 
 	delete attackProjectile;
 	delete polymorphCache;
@@ -4393,7 +4400,7 @@ bool Actor::OverrideActions()
 			case 1002:
 			case 1003:
 			case 1005:
-				action = GenerateAction("AttackReevaluate([GOODCUTOFF],10)");
+				action = GenerateCachedAction("AttackReevaluate([GOODCUTOFF],10)");
 				if (action) {
 					AddActionInFront(action);
 					return true;
@@ -4429,11 +4436,11 @@ void Actor::Panic(Scriptable *attacker, int panicmode)
 		SetBaseBit(IE_STATE_ID, STATE_PANIC, true);
 		break;
 	case PANIC_RANDOMWALK:
-		action = GenerateAction( "RandomWalk()" );
+		action = GenerateCachedAction( "RandomWalk()" );
 		SetBaseBit(IE_STATE_ID, STATE_PANIC, true);
 		break;
 	case PANIC_BERSERK:
-		action = GenerateAction( "Berserk()" );
+		action = GenerateCachedAction( "Berserk()" );
 		BaseStats[IE_CHECKFORBERSERK]=3;
 		//SetBaseBit(IE_STATE_ID, STATE_BERSERK, true);
 		break;
@@ -6276,7 +6283,7 @@ ITMExtHeader *Actor::GetRangedWeapon(WeaponInfo &wi) const
 	if (!wield) {
 		return NULL;
 	}
-	Item *item = gamedata->GetItem(wield->ItemResRef, true);
+	Item *item = GetPinnedItem(wield, PIN_AMMO);
 	if (!item) {
 		Log(WARNING, "Actor", "Missing or invalid ranged weapon item: %s!", wield->ItemResRef);
 		return NULL;
@@ -6289,9 +6296,7 @@ ITMExtHeader *Actor::GetRangedWeapon(WeaponInfo &wi) const
 	//not resetting wi.itemtype, since we want it to remain the one of the launcher
 	//wi.range is not set, the projectile has no effect on range?
 
-	ITMExtHeader *which = item->GetWeaponHeader(true);
-	gamedata->FreeItem(item, wield->ItemResRef, false);
-	return which;
+	return item->GetWeaponHeader(true);
 }
 
 int Actor::IsDualWielding() const
@@ -6303,7 +6308,7 @@ int Actor::IsDualWielding() const
 		return 0;
 	}
 
-	Item *itm = gamedata->GetItem(wield->ItemResRef, true);
+	Item *itm = GetPinnedItem(wield, PIN_OFFHAND);
 	if (!itm) {
 		Log(WARNING, "Actor", "Missing or invalid wielded weapon item: %s!", wield->ItemResRef);
 		return 0;
@@ -6311,11 +6316,26 @@ int Actor::IsDualWielding() const
 
 	//if the item is usable in weapon slot, then it is weapon
 	int weapon = core->CanUseItemType( SLOT_WEAPON, itm );
-	gamedata->FreeItem( itm, wield->ItemResRef, false );
 	//is just weapon>0 ok?
 	return (weapon>0)?1:0;
 }
 
+Item *Actor::GetPinnedItem(const CREItem *slotitem, int pin) const
+{
+	Item *item = pinnedItems[pin];
+	if (item && !strnicmp(item->Name, slotitem->ItemResRef, 8)) {
+		return item;
+	}
+
+	//the inventory changed since the last lookup
+	Item *newitem = gamedata->GetItem(slotitem->ItemResRef, true);
+	if (item) {
+		gamedata->FreeItem(item, item->Name, false);
+	}
+	pinnedItems[pin] = newitem;
+	return newitem;
+}
+
 //returns weapon header currently used (bow in case of bow+arrow)
 //if range is nonzero, then the returned header is valid
 ITMExtHeader *Actor::GetWeapon(WeaponInfo &wi, bool leftorright) const
@@ -6327,7 +6347,7 @@ ITMExtHeader *Actor::GetWeapon(WeaponInfo &wi, bool leftorright) const
 	if (!wield) {
 		return 0;
 	}
-	Item *item = gamedata->GetItem(wield->ItemResRef, true);
+	Item *item = GetPinnedItem(wield, leftorright ? PIN_OFFHAND : PIN_WEAPON);
 	if (!item) {
 		Log(WARNING, "Actor", "Missing or invalid weapon item: %s!", wield->ItemResRef);
 		return 0;
@@ -6371,9 +6391,7 @@ ITMExtHeader *Actor::GetWeapon(WeaponInfo &wi, bool leftorright) const
 		wi.critrange--;
 	}
 
-	//make sure we use 'false' in this freeitem
-	//so 'which' won't point into invalid memory
-	gamedata->FreeItem(item, wield->ItemResRef, false);
+	//the item stays pinned, so 'which' won't point into invalid memory
 	if (!which) {
 		return 0;
 	}
@@ -7809,7 +7827,7 @@ void Actor::UpdateActorState(ieDword gameTime) {
 				actionString = "NoAction()";
 				break;
 			}
-			Action *action = GenerateAction( actionString );
+			Action *action = GenerateCachedAction( actionString );
 			if (action) {
 				ReleaseCurrentAction();
 				AddActionInFront(action);
@@ -7819,7 +7837,7 @@ void Actor::UpdateActorState(ieDword gameTime) {
 		}
 
 		if (Modified[IE_CHECKFORBERSERK] && !LastTarget && SeeAnyOne(false, false) ) {
-			Action *action = GenerateAction( "Berserk()" );
+			Action *action = GenerateCachedAction( "Berserk()" );
 			if (action) {
 				ReleaseCurrentAction();
 				AddActionInFront(action);
@@ -11326,7 +11344,7 @@ char Actor::GetArmorCode() const
 	// IE_ARMOR_TYPE + 1 is the armor code, but we also need to look up robes specifically as they have 3 types :(
 	CREItem *itm = inventory.GetSlotItem(inventory.GetArmorSlot());
 	if (!itm) return '1';
-	Item *item = gamedata->GetItem(itm->ItemResRef, true);
+	Item *item = GetPinnedItem(itm, PIN_ARMOR);
 	if (!item) return '1';
 	bool wearingRobes = item->AnimationType[1] == 'W';
 
@@ -174,6 +174,13 @@ namespace GemRB {
 // 3 for blur, 8 for mirror images
 #define EXTRA_ACTORCOVERS 11
 
+//item definitions kept referenced for the gear queried in combat
+#define PIN_WEAPON   0
+#define PIN_OFFHAND  1
+#define PIN_AMMO     2
+#define PIN_ARMOR    3
+#define PIN_COUNT    4
+
 //flags for UseItem
 #define UI_SILENT    1       //no sound when used up
 #define UI_MISS      2       //ranged miss (projectile has no effects)
@@ -387,6 +394,7 @@ private:
 	CharAnimations* anims;
 	CharAnimations *shadowAnimations;
 	SpriteCover* extraCovers[EXTRA_ACTORCOVERS];
+	mutable Item* pinnedItems[PIN_COUNT];
 	ieByte SavingThrow[5];
 	ieByte weapSlotCount;
 	// true when command has been played after select
@@ -446,6 +454,9 @@ private:
 	ieDword GetKitIndex (ieDword kit, ieDword baseclass=0) const;
 	char GetArmorCode() const;
 	const char* GetArmorSound() const;
+	/* returns the definition of slotitem, reusing the one pinned last time
+	   if the item is still the same */
+	Item *GetPinnedItem(const CREItem *slotitem, int pin) const;
 public:
 	Actor(void);
 	~Actor(void);
@@ -22,7 +22,9 @@
 
 #include "win32def.h"
 
+#include "FileCache.h"
 #include "Interface.h"
+#include "ResourceManager.h"
 
 namespace GemRB {
 
@@ -223,6 +225,10 @@ bool FileStream::Modify(const char* fname)
 //Creating file in the cache
 bool FileStream::Create(const char* fname, SClass_ID ClassID)
 {
+	//a pending saved game member must not shadow the new file
+	char name[_MAX_PATH];
+	snprintf(name, _MAX_PATH, "%s.%s", fname, core->TypeExt(ClassID));
+	DropPendingCacheFile(name);
 	return Create(core->CachePath, fname, ClassID);
 }
 
@@ -246,6 +252,8 @@ bool FileStream::Create(const char *path)
 	if (!str->OpenNew(originalfile)) {
 		return false;
 	}
+	//the new file may provide or shadow a resource
+	ResourceManager::InvalidateLookups();
 	opened = true;
 	created = true;
 	Pos = 0;
@@ -57,9 +57,14 @@ bool Logger::SetLogLevel(log_level level)
 	return false;
 }
 
+bool Logger::WouldLog(log_level level) const
+{
+	return level <= myLevel;
+}
+
 void Logger::log(log_level level, const char* owner, const char* message, log_color color)
 {
-	if (level <= myLevel) {
+	if (WouldLog(level)) {
 		LogInternal(level, owner, message, color);
 	}
 }
@@ -59,6 +59,8 @@ public:
 	virtual void destroy();
 
 	bool SetLogLevel(log_level);
+	/** true if a message of this level would be logged */
+	bool WouldLog(log_level) const;
 	void log(log_level, const char* owner, const char* message, log_color color);
 protected:
 	virtual void LogInternal(log_level, const char*, const char*, log_color)=0;
@@ -41,9 +41,12 @@ FileLogger::~FileLogger()
 	delete log_file;
 }
 
-void FileLogger::print(const char *message)
+void FileLogger::flush()
 {
-	log_file->Write(message, strlen(message));
+	if (line.empty())
+		return;
+	log_file->Write(line.c_str(), line.length());
+	line.clear();
 }
 
 Logger* createFileLogger(DataStream* log_file)
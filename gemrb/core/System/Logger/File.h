@@ -30,7 +30,8 @@ public:
 	FileLogger(DataStream*);
 	virtual ~FileLogger();
 
-	void print(const char* message);
+protected:
+	void flush();
 
 private:
 	DataStream* log_file;
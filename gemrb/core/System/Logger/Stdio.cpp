@@ -33,7 +33,15 @@ StdioLogger::~StdioLogger()
 
 void StdioLogger::print(const char* message)
 {
-	fprintf(stdout, "%s", message);
+	line += message;
+}
+
+void StdioLogger::flush()
+{
+	if (line.empty())
+		return;
+	fputs(line.c_str(), stdout);
+	line.clear();
 }
 
 static const char* colors[] = {
@@ -108,11 +116,13 @@ void StdioLogger::LogInternal(log_level level, const char* owner, const char* me
 	textcolor(color);
 	print(message);
 	print("\n");
+	flush();
 }
 
 void StdioLogger::destroy()
 {
 	textcolor(DEFAULT);
+	flush();
 }
 
 Logger* createStdioLogger()
@@ -21,6 +21,8 @@
 
 #include "System/Logger.h" // for log_color
 
+#include <string>
+
 namespace GemRB {
 
 class GEM_EXPORT StdioLogger : public Logger {
@@ -32,7 +34,11 @@ protected:
 	virtual void LogInternal(log_level, const char* owner, const char* message, log_color color);
 	virtual void print(const char*);
 	virtual void textcolor(log_color);
+	/** writes out the collected line */
+	virtual void flush();
 	bool useColor;
+	//the pieces of the current line, written out together
+	std::string line;
 private:
 	void printBracket(const char *status, log_color color);
 	void printStatus(const char* status, log_color color);
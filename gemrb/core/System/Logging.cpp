@@ -72,6 +72,14 @@ static void vLog(log_level level, const char* owner, const char* message, log_co
 	if (theLogger.empty())
 		return;
 
+	// don't format messages nobody wants, like debug output
+	size_t i;
+	for (i = 0; i < theLogger.size(); ++i) {
+		if (theLogger[i]->WouldLog(level)) break;
+	}
+	if (i == theLogger.size())
+		return;
+
 	// Copied from System/StringBuffer.cpp
 #ifndef __va_copy
 	// Don't try to be smart.
@@ -92,7 +100,7 @@ static void vLog(log_level level, const char* owner, const char* message, log_co
 #endif
 	char buf[len+1];
 	vsnprintf(buf, len + 1, message, ap);
-	for (size_t i = 0; i < theLogger.size(); ++i) {
+	for (i = 0; i < theLogger.size(); ++i) {
 		theLogger[i]->log(level, owner, buf, color);
 	}
 }
@@ -73,8 +73,13 @@ struct DIR {
 	intptr_t hFile;
 };
 
+#define DT_UNKNOWN 0
+#define DT_DIR 4
+#define DT_REG 8
+
 struct dirent {
 	char d_name[_MAX_PATH];
+	unsigned char d_type;
 };
 
 // buffer which readdir returns
@@ -107,6 +112,7 @@ static dirent* readdir(DIR* dirp)
 	}
 
 	strcpy( de.d_name, c_file.name );
+	de.d_type = (c_file.attrib & _A_SUBDIR) ? DT_DIR : DT_REG;
 
 	return &de;
 }
@@ -540,6 +546,16 @@ void DirectoryIterator::SetFilterPredicate(FileFilterPredicate* p, bool chain)
 
 bool DirectoryIterator::IsDirectory()
 {
+#ifdef DT_DIR
+	// avoid a stat per entry when readdir already knows the type
+	// (symlinks and some filesystems report DT_UNKNOWN or DT_LNK)
+	unsigned char type = static_cast<dirent*>(Entry)->d_type;
+	if (type == DT_DIR) {
+		return true;
+	} else if (type == DT_REG) {
+		return false;
+	}
+#endif
 	char dtmp[_MAX_PATH];
 	GetFullPath(dtmp);
 	//this is needed on windows!!!
@@ -29,10 +29,74 @@
 
 namespace GemRB {
 
+//edge of a hit test grid cell in pixels
+#define REGION_CELL 128
+
+RegionGrid::RegionGrid()
+{
+	columns = rows = 0;
+}
+
+void RegionGrid::Build(const std::vector<Region> &boxes)
+{
+	cells.clear();
+	columns = rows = 0;
+	if (boxes.empty()) {
+		return;
+	}
+
+	int x1 = boxes[0].x, y1 = boxes[0].y;
+	int x2 = x1 + boxes[0].w, y2 = y1 + boxes[0].h;
+	for (const Region &box : boxes) {
+		x1 = std::min(x1, box.x);
+		y1 = std::min(y1, box.y);
+		x2 = std::max(x2, box.x + box.w);
+		y2 = std::max(y2, box.y + box.h);
+	}
+	origin = Point(x1, y1);
+	//the bounding boxes include their right and bottom edges
+	columns = (x2 - x1) / REGION_CELL + 1;
+	rows = (y2 - y1) / REGION_CELL + 1;
+	cells.resize(columns * rows);
+
+	for (unsigned int i = 0; i < boxes.size(); i++) {
+		const Region &box = boxes[i];
+		int cx1 = (box.x - origin.x) / REGION_CELL;
+		int cx2 = (box.x + box.w - origin.x) / REGION_CELL;
+		int cy1 = (box.y - origin.y) / REGION_CELL;
+		int cy2 = (box.y + box.h - origin.y) / REGION_CELL;
+		for (int y = cy1; y <= cy2; y++) {
+			for (int x = cx1; x <= cx2; x++) {
+				cells[y * columns + x].push_back(i);
+			}
+		}
+	}
+}
+
+const std::vector<unsigned int> *RegionGrid::GetCandidates(const Point &p) const
+{
+	int x = p.x - origin.x;
+	int y = p.y - origin.y;
+	if (x < 0 || y < 0) {
+		return NULL;
+	}
+	x /= REGION_CELL;
+	y /= REGION_CELL;
+	if (x >= columns || y >= rows) {
+		return NULL;
+	}
+	const std::vector<unsigned int> &cell = cells[y * columns + x];
+	if (cell.empty()) {
+		return NULL;
+	}
+	return &cell;
+}
+
 TileMap::TileMap(void)
 {
 	XCellCount = 0;
 	YCellCount = 0;
+	doorGridValid = containerGridValid = infoPointGridValid = false;
 	LargeMap = !core->HasFeature(GF_SMALL_FOG);
 }
 
@@ -108,6 +172,8 @@ Door* TileMap::AddDoor(const char *ID, const char* Name, unsigned int Flags,
 	door->SetName( ID );
 	door->SetScriptName( Name );
 	doors.push_back( door );
+	scriptables[door->GetGlobalID()] = door;
+	doorGridValid = false;
 	return door;
 }
 
@@ -121,7 +187,31 @@ Door* TileMap::GetDoor(unsigned int idx) const
 
 Door* TileMap::GetDoor(const Point &p) const
 {
-	for (size_t i = 0; i < doors.size(); i++) {
+	if (!doorGridValid) {
+		//cover both states, so toggling a door needs no rebuild
+		std::vector<Region> boxes;
+		for (auto door : doors) {
+			Region box = door->closed ? door->closed->BBox : door->open->BBox;
+			if (door->open && door->closed) {
+				const Region &other = door->open->BBox;
+				int x2 = std::max(box.x + box.w, other.x + other.w);
+				int y2 = std::max(box.y + box.h, other.y + other.h);
+				box.x = std::min(box.x, other.x);
+				box.y = std::min(box.y, other.y);
+				box.w = x2 - box.x;
+				box.h = y2 - box.y;
+			}
+			boxes.push_back(box);
+		}
+		doorGrid.Build(boxes);
+		doorGridValid = true;
+	}
+	const std::vector<unsigned int> *candidates = doorGrid.GetCandidates(p);
+	if (!candidates) {
+		return NULL;
+	}
+
+	for (auto i : *candidates) {
 		Gem_Polygon *doorpoly;
 
 		Door* door = doors[i];
@@ -210,12 +300,23 @@ void TileMap::AddRainOverlay(TileOverlay* overlay)
 	rain_overlays.push_back( overlay );
 }
 
-void TileMap::DrawOverlays(Region screen, int rain, int flags)
+// explored_mask should only be passed if the fog of war is drawn afterwards
+void TileMap::DrawOverlays(Region screen, int rain, int flags, const ieByte* explored_mask)
 {
+	FogMask fog;
+	hiddenTiles.clear();
+	if (explored_mask) {
+		fog.explored = explored_mask;
+		fog.w = XCellCount * 2 + LargeMap;
+		fog.h = YCellCount * 2 + LargeMap;
+		fog.large = LargeMap;
+		fog.skipped = core->VerifyFog ? &hiddenTiles : NULL;
+	}
+
 	if (rain) {
-		overlays[0]->Draw( screen, rain_overlays, flags );
+		overlays[0]->Draw( screen, rain_overlays, flags, explored_mask ? &fog : NULL );
 	} else {
-		overlays[0]->Draw( screen, overlays, flags );
+		overlays[0]->Draw( screen, overlays, flags, explored_mask ? &fog : NULL );
 	}
 }
 
@@ -273,12 +374,16 @@ void TileMap::DrawFogOfWar(ieByte* explored_mask, ieByte* visible_mask, Region v
 		dx++;
 		dy++;
 	}
+	std::vector<Region> black;
 	for (int y = sy; y < dy && y < h; y++) {
 		for (int x = sx; x < dx && x < w; x++) {
 			Region r = Region(x0 + viewport.x + ( (x - sx) * CELL_SIZE ), y0 + viewport.y + ( (y - sy) * CELL_SIZE ), CELL_SIZE, CELL_SIZE);
 			if (! IS_EXPLORED( x, y )) {
 				// Unexplored tiles are all black
 				vid->DrawRect(r, ColorBlack, true, true);
+				if (!hiddenTiles.empty()) {
+					black.push_back(r);
+				}
 				continue;  // Don't draw 'invisible' fog
 			}
 			else {
@@ -340,6 +445,9 @@ void TileMap::DrawFogOfWar(ieByte* explored_mask, ieByte* visible_mask, Region v
 					break;
 				case 15: //this is black too
 					vid->DrawRect(r, ColorBlack, true, true);
+					if (!hiddenTiles.empty()) {
+						black.push_back(r);
+					}
 					break;
 				}
 			}
@@ -413,12 +521,33 @@ void TileMap::DrawFogOfWar(ieByte* explored_mask, ieByte* visible_mask, Region v
 			}
 		}
 	}
+
+	// the skipped tiles have to be completely painted black; the black
+	// cells don't overlap, so it is enough to add up the covered area
+	for (size_t i = 0; i < hiddenTiles.size(); i++) {
+		const Region &tile = hiddenTiles[i];
+		if (tile.w <= 0 || tile.h <= 0) {
+			continue;
+		}
+		int covered = 0;
+		for (size_t j = 0; j < black.size(); j++) {
+			Region part = tile.Intersect(black[j]);
+			if (part.w > 0 && part.h > 0) {
+				covered += part.w * part.h;
+			}
+		}
+		if (covered != tile.w * tile.h) {
+			Log(ERROR, "TileMap", "Skipped tile at %d,%d is not hidden by the fog of war!", tile.x, tile.y);
+		}
+	}
 }
 
 //containers
 void TileMap::AddContainer(Container *c)
 {
 	containers.push_back(c);
+	scriptables[c->GetGlobalID()] = c;
+	containerGridValid = false;
 }
 
 Container* TileMap::GetContainer(unsigned int idx) const
@@ -444,7 +573,20 @@ Container* TileMap::GetContainer(const char* Name) const
 //in this case, empty piles won't be found!
 Container* TileMap::GetContainer(const Point &position, int type) const
 {
-	for (size_t i = 0; i < containers.size(); i++) {
+	if (!containerGridValid) {
+		std::vector<Region> boxes;
+		for (auto c : containers) {
+			boxes.push_back(c->outline->BBox);
+		}
+		containerGrid.Build(boxes);
+		containerGridValid = true;
+	}
+	const std::vector<unsigned int> *candidates = containerGrid.GetCandidates(position);
+	if (!candidates) {
+		return NULL;
+	}
+
+	for (auto i : *candidates) {
 		Container* c = containers[i];
 		if (type!=-1) {
 			if (c->Type!=type) {
@@ -513,6 +655,8 @@ int TileMap::CleanupContainer(Container *container)
 	for (size_t i = 0; i < containers.size(); i++) {
 		if (containers[i]==container) {
 			containers.erase(containers.begin()+i);
+			scriptables.erase(container->GetGlobalID());
+			containerGridValid = false;
 			delete container;
 			return 1;
 		}
@@ -548,13 +692,37 @@ InfoPoint* TileMap::AddInfoPoint(const char* Name, unsigned short Type,
 	ip->outline = outline;
 	//ip->Active = true; //set active on creation
 	infoPoints.push_back( ip );
+	scriptables[ip->GetGlobalID()] = ip;
+	infoPointGridValid = false;
 	return ip;
 }
 
+Scriptable* TileMap::GetScriptableByGlobalID(ieDword objectID) const
+{
+	std::map<ieDword, Scriptable*>::const_iterator it = scriptables.find(objectID);
+	if (it == scriptables.end()) {
+		return NULL;
+	}
+	return it->second;
+}
+
 //if detectable is set, then only detectable infopoints will be returned
 InfoPoint* TileMap::GetInfoPoint(const Point &p, bool detectable) const
 {
-	for (size_t i = 0; i < infoPoints.size(); i++) {
+	if (!infoPointGridValid) {
+		std::vector<Region> boxes;
+		for (auto ip : infoPoints) {
+			boxes.push_back(ip->outline->BBox);
+		}
+		infoPointGrid.Build(boxes);
+		infoPointGridValid = true;
+	}
+	const std::vector<unsigned int> *candidates = infoPointGrid.GetCandidates(p);
+	if (!candidates) {
+		return NULL;
+	}
+
+	for (auto i : *candidates) {
 		InfoPoint* ip = infoPoints[i];
 		//these flags disable any kind of user interaction
 		//scripts can still access an infopoint by name
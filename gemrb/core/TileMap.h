@@ -26,6 +26,8 @@
 #include "Polygon.h"
 #include "TileOverlay.h"
 
+#include <map>
+
 namespace GemRB {
 
 //special container types
@@ -34,16 +36,38 @@ namespace GemRB {
 class Container;
 class Door;
 class InfoPoint;
+class Scriptable;
 class TileObject;
 
+//buckets region indices by the grid cells their bounding box touches,
+//so hit tests only look at the regions near the point
+class RegionGrid {
+public:
+	RegionGrid();
+	void Build(const std::vector<Region> &boxes);
+	//the indices are in ascending order, or NULL if nothing is near
+	const std::vector<unsigned int> *GetCandidates(const Point &p) const;
+private:
+	Point origin;
+	int columns, rows;
+	std::vector< std::vector<unsigned int> > cells;
+};
+
 class GEM_EXPORT TileMap {
 private:
 	std::vector< TileOverlay*> overlays;
 	std::vector< TileOverlay*> rain_overlays;
+	//tiles skipped under the fog of war, only collected with VerifyFog
+	std::vector<Region> hiddenTiles;
 	std::vector< Door*> doors;
 	std::vector< Container*> containers;
 	std::vector< InfoPoint*> infoPoints;
 	std::vector< TileObject*> tiles;
+	//doors, containers and infopoints by global ID
+	std::map<ieDword, Scriptable*> scriptables;
+	//hit test grids, rebuilt on the first query after a region is added
+	mutable RegionGrid doorGrid, containerGrid, infoPointGrid;
+	mutable bool doorGridValid, containerGridValid, infoPointGridValid;
 	bool LargeMap;
 public:
 	TileMap(void);
@@ -83,6 +107,9 @@ public:
 	InfoPoint* AdjustNearestTravel(Point &p);
 	size_t GetInfoPointCount() const { return infoPoints.size(); }
 
+	//gets a door, container or infopoint by global ID
+	Scriptable* GetScriptableByGlobalID(ieDword objectID) const;
+
 	TileObject* AddTile(const char* ID, const char* Name, unsigned int Flags,
 		unsigned short* openindices, int opencount,unsigned short* closeindices, int closecount);
 	TileObject* GetTile(unsigned int idx);
@@ -92,7 +119,7 @@ public:
 	void ClearOverlays();
 	void AddOverlay(TileOverlay* overlay);
 	void AddRainOverlay(TileOverlay* overlay);
-	void DrawOverlays(Region screen, int rain, int flags);
+	void DrawOverlays(Region screen, int rain, int flags, const ieByte* explored_mask = NULL);
 	void DrawFogOfWar(ieByte* explored_mask, ieByte* visible_mask, Region viewport);
 	Point GetMapSize();
 public:
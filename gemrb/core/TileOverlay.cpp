@@ -29,6 +29,31 @@ namespace GemRB {
 
 bool RedrawTile = false;
 
+// Fog cells are half a tile, shifted by a quarter tile on large maps, and
+// unexplored ones are filled with black. Also demand the ring of cells
+// around the tile, so a differently clamped fog viewport can't expose it.
+bool FogMask::IsTileHidden(int x, int y) const
+{
+	int cx0 = x * 2 - 1;
+	int cy0 = y * 2 - 1;
+	int cx1 = x * 2 + 2 + large;
+	int cy1 = y * 2 + 2 + large;
+	if (cx0 < 0 || cy0 < 0 || cx1 >= w || cy1 >= h) {
+		// points outside the map count as explored
+		return false;
+	}
+
+	for (int cy = cy0; cy <= cy1; cy++) {
+		for (int cx = cx0; cx <= cx1; cx++) {
+			int b0 = cy * w + cx;
+			if (explored[b0 / 8] & (1 << (b0 % 8))) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 TileOverlay::TileOverlay(int Width, int Height)
 {
 	w = Width;
@@ -79,7 +104,7 @@ void TileOverlay::BumpViewport(const Region &viewport, Region &vp)
 	}
 }
 
-void TileOverlay::Draw(Region viewport, std::vector< TileOverlay*> &overlays, int flags)
+void TileOverlay::Draw(Region viewport, std::vector< TileOverlay*> &overlays, int flags, const FogMask* fog)
 {
 	Video* vid = core->GetVideoDriver();
 	Region vp = vid->GetViewport();
@@ -94,6 +119,16 @@ void TileOverlay::Draw(Region viewport, std::vector< TileOverlay*> &overlays, in
 
 	for (int y = sy; y < dy && y < h; y++) {
 		for (int x = sx; x < dx && x < w; x++) {
+			//the fog of war will paint it black anyway
+			if (fog && fog->IsTileHidden(x, y)) {
+				if (fog->skipped) {
+					Region screen = vid->GetViewport();
+					fog->skipped->push_back(Region(viewport.x + (x * 64) - screen.x,
+						viewport.y + (y * 64) - screen.y, 64, 64).Intersect(viewport));
+				}
+				continue;
+			}
+
 			Tile* tile = tiles[( y* w ) + x];
 
 			//draw door tiles if there are any
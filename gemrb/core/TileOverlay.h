@@ -22,6 +22,7 @@
 #define TILEOVERLAY_H
 
 #include "exports.h"
+#include "ie_types.h"
 
 #include "Tile.h"
 
@@ -31,6 +32,18 @@ namespace GemRB {
 
 extern bool RedrawTile;
 
+// the explored bitmap of the fog of war drawn over the overlay, so tiles
+// that would end up completely black can be skipped
+struct FogMask {
+	const ieByte* explored;
+	int w, h;
+	bool large;
+	// if set, the screen area of every skipped tile is collected here
+	std::vector<Region>* skipped;
+
+	bool IsTileHidden(int x, int y) const;
+};
+
 class GEM_EXPORT TileOverlay {
 public:
 	int w, h;
@@ -41,7 +54,7 @@ public:
 	TileOverlay(int Width, int Height);
 	~TileOverlay(void);
 	void AddTile(Tile* tile);
-	void Draw(Region viewport, std::vector< TileOverlay*> &overlays, int flags);
+	void Draw(Region viewport, std::vector< TileOverlay*> &overlays, int flags, const FogMask* fog = NULL);
 	void BumpViewport(const Region &viewport, Region &vp);
 };
 
@@ -66,7 +66,7 @@ inline unsigned int Variables::MyCompareKey(const char* key, const char *str) co
 	return 0;
 }
 
-inline unsigned int Variables::MyHashKey(const char* key) const
+inline unsigned int Variables::MyHashKey(const char* key)
 {
 	unsigned int nHash = 0;
 	for (int i = 0; key[i] && i < MAX_VARIABLE_LENGTH; i++) {
@@ -76,6 +76,35 @@ inline unsigned int Variables::MyHashKey(const char* key) const
 	}
 	return nHash;
 }
+
+// every table gets a distinct epoch, so a handle can never mistake a slot of
+// a deleted table for one in a new table allocated at the same address
+static unsigned int EpochCounter = 0;
+
+Variables::Handle::Handle()
+{
+	key[0] = 0;
+	nHash = 0;
+	owner = NULL;
+	epoch = 0;
+	slot = NULL;
+}
+
+Variables::Handle::Handle(const char* key)
+{
+	SetKey(key);
+}
+
+void Variables::Handle::SetKey(const char* newKey)
+{
+	// the lookups never look past MAX_VARIABLE_LENGTH characters
+	strlcpy(key, newKey, sizeof(key));
+	nHash = MyHashKey(key);
+	owner = NULL;
+	epoch = 0;
+	slot = NULL;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // functions
 Variables::iterator Variables::GetNextAssoc(iterator rNextPosition, const char*& rKey,
@@ -121,6 +150,12 @@ Variables::Variables(int nBlockSize, int nHashTableSize)
 	m_pBlocks = NULL;
 	m_nBlockSize = nBlockSize;
 	m_type = GEM_VARIABLES_INT;
+	m_nEpoch = ++EpochCounter;
+}
+
+void Variables::Invalidate()
+{
+	m_nEpoch = ++EpochCounter;
 }
 
 void Variables::InitHashTable(unsigned int nHashSize, bool bAllocNow)
@@ -146,6 +181,7 @@ void Variables::InitHashTable(unsigned int nHashSize, bool bAllocNow)
 
 void Variables::RemoveAll(ReleaseFun fun)
 {
+	Invalidate();
 	if (m_pHashTable != NULL) {
 		// destroy elements (values and keys)
 		for (unsigned int nHash = 0; nHash < m_nHashTableSize; nHash++) {
@@ -246,11 +282,8 @@ void Variables::FreeAssoc(Variables::MyAssoc* pAssoc)
 	}
 }
 
-Variables::MyAssoc* Variables::GetAssocAt(const char* key, unsigned int& nHash) const
-	// find association (or return NULL)
+Variables::MyAssoc* Variables::FindAssoc(const char* key, unsigned int nHash) const
 {
-	nHash = MyHashKey( key ) % m_nHashTableSize;
-
 	if (m_pHashTable == NULL) {
 		return NULL;
 	}
@@ -274,6 +307,31 @@ Variables::MyAssoc* Variables::GetAssocAt(const char* key, unsigned int& nHash)
 	return NULL;
 }
 
+Variables::MyAssoc* Variables::GetAssocAt(const char* key, unsigned int& nHash) const
+	// find association (or return NULL)
+{
+	nHash = MyHashKey( key ) % m_nHashTableSize;
+	return FindAssoc( key, nHash );
+}
+
+Variables::MyAssoc* Variables::GetAssocAt(const Handle& handle, unsigned int& nHash) const
+	// same, but reusing the precomputed hash and the last resolved slot
+{
+	nHash = handle.nHash % m_nHashTableSize;
+	if (handle.owner == this && handle.epoch == m_nEpoch) {
+		return handle.slot;
+	}
+
+	Variables::MyAssoc* pAssoc = FindAssoc( handle.key, nHash );
+	// misses aren't cached, the variable may get created later
+	if (pAssoc) {
+		handle.owner = this;
+		handle.epoch = m_nEpoch;
+		handle.slot = pAssoc;
+	}
+	return pAssoc;
+}
+
 int Variables::GetValueLength(const char* key) const
 {
 	unsigned int nHash;
@@ -338,6 +396,19 @@ bool Variables::Lookup(const char* key, ieDword& rValue) const
 	return true;
 }
 
+bool Variables::Lookup(const Handle& handle, ieDword& rValue) const
+{
+	unsigned int nHash;
+	assert(m_type==GEM_VARIABLES_INT);
+	Variables::MyAssoc* pAssoc = GetAssocAt( handle, nHash );
+	if (pAssoc == NULL) {
+		return false;
+	} // not in map
+
+	rValue = pAssoc->Value.nValue;
+	return true;
+}
+
 void Variables::SetAtCopy(const char* key, const char* value)
 {
 	size_t len = strlen(value)+1;
@@ -448,6 +519,20 @@ void Variables::SetAt(const char* key, ieDword value, bool nocreate)
 	}
 }
 
+void Variables::SetAt(const Handle& handle, ieDword value, bool nocreate)
+{
+	unsigned int nHash;
+	Variables::MyAssoc* pAssoc;
+
+	assert( m_type == GEM_VARIABLES_INT );
+	if (( pAssoc = GetAssocAt( handle, nHash ) ) == NULL) {
+		// creation is the slow path anyway
+		SetAt( handle.key, value, nocreate );
+		return;
+	}
+	pAssoc->Value.nValue = value;
+}
+
 void Variables::Remove(const char* key)
 {
 	unsigned int nHash;
@@ -472,6 +557,7 @@ void Variables::Remove(const char* key)
 		prev->pNext = pAssoc->pNext;		
 	}
 	pAssoc->pNext = 0;
+	Invalidate();
 	FreeAssoc(pAssoc);
 }
 
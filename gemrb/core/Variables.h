@@ -59,6 +59,24 @@ protected:
 public:
 	// abstract iteration position
 	typedef MyAssoc *iterator;
+
+	// a key hashed once up front (eg. when a script is loaded), which also
+	// remembers the slot it resolved to; the slot is trusted only while the
+	// owning table hasn't dropped any entry since (see m_nEpoch)
+	class GEM_EXPORT Handle {
+	public:
+		Handle();
+		explicit Handle(const char* key);
+		void SetKey(const char* key);
+		const char* GetKey() const { return key; }
+	private:
+		char key[MAX_VARIABLE_LENGTH + 1];
+		unsigned int nHash;
+		mutable const Variables* owner;
+		mutable unsigned int epoch;
+		mutable MyAssoc* slot;
+		friend class Variables;
+	};
 public:
 	// Construction
 	Variables(int nBlockSize = 10, int nHashTableSize = 2049);
@@ -93,6 +111,7 @@ public:
 	bool Lookup(const char* key, ieDword& rValue) const;
 	bool Lookup(const char* key, char*& dest) const;
 	bool Lookup(const char* key, void*& dest) const;
+	bool Lookup(const Handle& handle, ieDword& rValue) const;
 
 	// Operations
 	void SetAtCopy(const char* key, const char* newValue);
@@ -100,6 +119,7 @@ public:
 	void SetAt(const char* key, char* newValue);
 	void SetAt(const char* key, void* newValue);
 	void SetAt(const char* key, ieDword newValue, bool nocreate=false);
+	void SetAt(const Handle& handle, ieDword newValue, bool nocreate=false);
 	void Remove(const char* key);
 	void RemoveAll(ReleaseFun fun);
 	void InitHashTable(unsigned int hashSize, bool bAllocNow = true);
@@ -119,13 +139,17 @@ protected:
 	MemBlock* m_pBlocks;
 	int m_nBlockSize;
 	int m_type; //could be string or ieDword 
+	unsigned int m_nEpoch; //changes whenever an association is freed
 
 	Variables::MyAssoc* NewAssoc(const char* key);
 	void FreeAssoc(Variables::MyAssoc*);
 	Variables::MyAssoc* GetAssocAt(const char*, unsigned int&) const;
+	Variables::MyAssoc* GetAssocAt(const Handle&, unsigned int&) const;
+	Variables::MyAssoc* FindAssoc(const char*, unsigned int) const;
+	void Invalidate();
 	inline bool MyCopyKey(char*& dest, const char* key) const;
 	inline unsigned int MyCompareKey(const char* key, const char *str) const;
-	inline unsigned int MyHashKey(const char*) const;
+	static inline unsigned int MyHashKey(const char*);
 
 public:
 	~Variables();
@@ -377,12 +377,9 @@ void Video::MoveViewportTo(int x, int y)
 
 void Video::InitSpriteCover(SpriteCover* sc, int flags)
 {
-	int i;
 	sc->flags = flags;
 	sc->pixels = new unsigned char[sc->Width * sc->Height];
-	for (i = 0; i < sc->Width*sc->Height; ++i)
-		sc->pixels[i] = 0;
-	
+	memset(sc->pixels, 0, sc->Width * sc->Height);
 }
 
 // flags: 0 - never dither (full cover)
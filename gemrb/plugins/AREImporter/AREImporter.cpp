@@ -42,8 +42,10 @@
 #include "Scriptable/Door.h"
 #include "Scriptable/InfoPoint.h"
 #include "System/FileStream.h"
+#include "System/MemoryStream.h"
 #include "System/SlicedStream.h"
 
+#include <map>
 #include <stdlib.h>
 #ifdef ANDROID
 // android lacks mblen
@@ -363,6 +365,60 @@ inline ieDword FixIWD2DoorFlags(ieDword Flags, bool reverse)
 	return Flags = (Flags & ~maskOff) | maskOn;
 }
 
+//the size of an actor entry and the offsets of the fields we peek at
+#define ACTOR_ENTRY_SIZE 0x110
+#define ACTOR_FLAGS_OFFSET 0x28
+#define ACTOR_CRE_OFFSET 0x80
+
+typedef std::map<std::string, MemoryStream*> CreatureCache;
+
+//counts how many actors of the area use each external creature file
+static void CountCreatureFiles(DataStream *str, ieDword ActorOffset, ieDword ActorCount, std::map<std::string, int> &counts)
+{
+	for (ieDword i = 0; i < ActorCount; i++) {
+		ieDword Flags;
+		ieResRef CreResRef;
+		ieDword CreOffset;
+
+		str->Seek(ActorOffset + i * ACTOR_ENTRY_SIZE + ACTOR_FLAGS_OFFSET, GEM_STREAM_START);
+		str->ReadDword(&Flags);
+		str->Seek(ActorOffset + i * ACTOR_ENTRY_SIZE + ACTOR_CRE_OFFSET, GEM_STREAM_START);
+		str->ReadResRef(CreResRef);
+		str->ReadDword(&CreOffset);
+		if (CreOffset != 0 && !(Flags&1)) {
+			continue; //embedded
+		}
+		strnlwrcpy(CreResRef, CreResRef, 8);
+		counts[CreResRef]++;
+	}
+	str->Seek(ActorOffset, GEM_STREAM_START);
+}
+
+//identical creatures (guards, townsfolk) are common, so their file is only
+//located and read once, every actor then gets its own in-memory copy
+static DataStream* GetCachedCreature(const ieResRef CreResRef, CreatureCache &cache)
+{
+	CreatureCache::iterator it = cache.find(CreResRef);
+	if (it != cache.end()) {
+		return it->second ? it->second->Clone() : NULL;
+	}
+
+	DataStream *crefile = gamedata->GetResource(CreResRef, IE_CRE_CLASS_ID);
+	MemoryStream *mem = NULL;
+	if (crefile) {
+		unsigned long size = crefile->Size();
+		void *data = malloc(size);
+		if (crefile->Read(data, size) == (int) size) {
+			mem = new MemoryStream(crefile->originalfile, data, size);
+		} else {
+			free(data);
+		}
+		delete crefile;
+	}
+	cache[CreResRef] = mem;
+	return mem ? mem->Clone() : NULL;
+}
+
 static Ambient* SetupMainAmbients(Map *map, bool day_or_night) {
 	ieResRef *main1[2] = { &map->SongHeader.MainNightAmbient1, &map->SongHeader.MainDayAmbient1 };
 	ieResRef *main2[2] = { &map->SongHeader.MainNightAmbient2, &map->SongHeader.MainDayAmbient2 };
@@ -1074,6 +1130,9 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 		Log(WARNING, "AREImporter", "No Actor Manager Available, skipping actors");
 	} else {
 		PluginHolder<ActorMgr> actmgr(IE_CRE_CLASS_ID);
+		std::map<std::string, int> creCounts;
+		CreatureCache creCache;
+		CountCreatureFiles(str, ActorOffset, ActorCount, creCounts);
 		for (i = 0; i < ActorCount; i++) {
 			ieVariable DefaultName;
 			ieResRef CreResRef;
@@ -1129,7 +1188,12 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 			if (CreOffset != 0 && !(Flags&1) ) {
 				crefile = SliceStream( str, CreOffset, CreSize, true );
 			} else {
-				crefile = gamedata->GetResource( CreResRef, IE_CRE_CLASS_ID );
+				strnlwrcpy(CreResRef, CreResRef, 8);
+				if (creCounts[CreResRef] > 1) {
+					crefile = GetCachedCreature(CreResRef, creCache);
+				} else {
+					crefile = gamedata->GetResource( CreResRef, IE_CRE_CLASS_ID );
+				}
 			}
 			if(!actmgr->Open(crefile)) {
 				Log(ERROR, "AREImporter", "Couldn't read actor: %s!", CreResRef);
@@ -1191,6 +1255,9 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 			ab->RemovalTime = RemovalTime;
 			ab->RefreshEffects(NULL);
 		}
+		for (CreatureCache::iterator it = creCache.begin(); it != creCache.end(); ++it) {
+			delete it->second;
+		}
 	}
 
 	int pst = core->HasFeature( GF_AUTOMAP_INI );
@@ -44,6 +44,10 @@
 #include <cassert>
 #include <cstdio>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -83,7 +87,7 @@ BIKPlayer::BIKPlayer(void)
 	timer_last_sec = timer_last_usec = frame_wait = c_col_lastval = 0;
 	outputwidth = outputheight = video_frameskip = video_skippedframes = 0;
 	s_frame_len = s_overlap_len = s_num_bands = s_block_size = 0;
-	video_rendered_frame = done = validVideo = s_audio = false;
+	video_rendered_frame = done = validVideo = s_audio = benchmark = false;
 	s_channels = s_first = s_stream = s_root = 0;
 	s_bands = NULL;
 }
@@ -233,7 +237,7 @@ int BIKPlayer::Play()
 	}
 	//Start Movie Playback
 	frameCount = 0;
-	int ret = doPlay( );
+	int ret = core->BenchmarkMovies ? doBenchmark() : doPlay();
 
 	if (s_stream > -1)
 		EndAudio();
@@ -293,7 +297,7 @@ void BIKPlayer::timer_wait()
 
 bool BIKPlayer::next_frame()
 {
-	if (timer_last_sec) {
+	if (timer_last_sec && !benchmark) {
 		timer_wait();
 	}
 	if(frameCount>=header.framecount) {
@@ -351,6 +355,27 @@ int BIKPlayer::doPlay()
 	return 0;
 }
 
+int BIKPlayer::doBenchmark()
+{
+	long start_sec, start_usec, sec, usec;
+
+	// no sound and no movie screen, only the video decoding is measured
+	s_stream = -1;
+	benchmark = true;
+	if (video_init(header.width, header.height)) {
+		return 2;
+	}
+
+	get_current_time(start_sec, start_usec);
+	while (next_frame()) ;
+	get_current_time(sec, usec);
+
+	long msec = (sec - start_sec) * 1000 + (usec - start_usec) / 1000;
+	Log(MESSAGE, "BIKPlayer", "Decoded %u frames of %ux%u in %ldms: %.2f fps",
+		frameCount, header.width, header.height, msec, msec ? frameCount * 1000.0 / msec : 0.0);
+	return 0;
+}
+
 unsigned int BIKPlayer::fileRead(unsigned int pos, void* buf, unsigned int count)
 {
 	str->Seek(pos, GEM_STREAM_START);
@@ -638,17 +663,43 @@ static inline int float_to_int16_one(const float *src){
 	return (int32_t) (f);
 }
 
+#ifdef __SSE2__
+// clamps like float_to_int16_one
+static inline __m128i float_to_int16_four(const float *src)
+{
+	__m128 f = _mm_loadu_ps(src);
+	f = _mm_min_ps(_mm_max_ps(f, _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+	return _mm_cvttps_epi32(f);
+}
+#endif
+
 static void ff_float_to_int16_interleave_c(int16_t *dst, const float **src, long len, int channels){
-	int i;
+	long i = 0;
 	if(channels==2) {
-		for(i=0; i<len; i++) {
+#ifdef __SSE2__
+		for(; i+4<=len; i+=4) {
+			__m128i l = float_to_int16_four(src[0]+i);
+			__m128i r = float_to_int16_four(src[1]+i);
+			__m128i lo = _mm_unpacklo_epi32(l, r);
+			__m128i hi = _mm_unpackhi_epi32(l, r);
+			_mm_storeu_si128((__m128i *) (dst+2*i), _mm_packs_epi32(lo, hi));
+		}
+#endif
+		for(; i<len; i++) {
 			dst[2*i]   = float_to_int16_one(src[0]+i);
 			dst[2*i+1] = float_to_int16_one(src[1]+i);
 		}
 		return;
 	}
 	//one channel
-	for(i=0; i<len; i++) {
+#ifdef __SSE2__
+	for(; i+8<=len; i+=8) {
+		__m128i a = float_to_int16_four(src[0]+i);
+		__m128i b = float_to_int16_four(src[0]+i+4);
+		_mm_storeu_si128((__m128i *) (dst+i), _mm_packs_epi32(a, b));
+	}
+#endif
+	for(; i<len; i++) {
 		dst[i] = float_to_int16_one(src[0]+i);
 	}
 }
@@ -783,7 +834,7 @@ int BIKPlayer::DecodeAudioFrame(void *data, int data_size)
  * @param gb    context for reading bits
  * @param block place for storing coefficients
  * @param scan  scan order table
- * @return 0 for success, negative value in other cases
+ * @return the number of AC coefficients read (0 means only the DC is set)
  */
 int BIKPlayer::read_dct_coeffs(DCTELEM block[64], const uint8_t *scan, bool is_intra)
 {
@@ -870,7 +921,7 @@ int BIKPlayer::read_dct_coeffs(DCTELEM block[64], const uint8_t *scan, bool is_i
 		block[scan[idx]] = (block[scan[idx]] * quant[idx]) >> 11;
 	}
 
-	return 0;
+	return coef_count;
 }
 
 /**
@@ -1254,6 +1305,32 @@ static void get_pixels(DCTELEM *block, const uint8_t *pixels, int line_size)
 	}
 }
 
+#ifdef __SSE2__
+static void put_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
+{
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	for (int i = 0; i < 8; i++) {
+		// keep the low byte, like the scalar assignment would
+		__m128i row = _mm_and_si128(_mm_loadu_si128((const __m128i *) block), mask);
+		_mm_storel_epi64((__m128i *) pixels, _mm_packus_epi16(row, row));
+		pixels += line_size;
+		block += 8;
+	}
+}
+
+static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
+{
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	const __m128i zero = _mm_setzero_si128();
+	for (int i = 0; i < 8; i++) {
+		__m128i row = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) pixels), zero);
+		row = _mm_and_si128(_mm_add_epi16(row, _mm_loadu_si128((const __m128i *) block)), mask);
+		_mm_storel_epi64((__m128i *) pixels, _mm_packus_epi16(row, row));
+		pixels += line_size;
+		block += 8;
+	}
+}
+#else
 static void put_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
 {
 	int i;
@@ -1290,6 +1367,7 @@ static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int lin
 		block += 8;
 	}
 }
+#endif
 
 static inline void copy_block(DCTELEM block[64], const uint8_t *src, uint8_t *dst, int stride)
 {
@@ -1306,6 +1384,12 @@ static void bink_idct(DCTELEM *block)
 	int tblock[64];
 
 	for (i = 0; i < 8; i++) {
+		// a column with only its DC set stays flat
+		if (!(block[i+8] | block[i+16] | block[i+24] | block[i+32] | block[i+40] | block[i+48] | block[i+56])) {
+			tblock[i+ 0] = tblock[i+ 8] = tblock[i+16] = tblock[i+24] =
+			tblock[i+32] = tblock[i+40] = tblock[i+48] = tblock[i+56] = block[i];
+			continue;
+		}
 		t0 = block[i+ 0] + block[i+32];
 		t1 = block[i+ 0] - block[i+32];
 		t2 = block[i+16] + block[i+48];
@@ -1376,14 +1460,34 @@ static void bink_idct(DCTELEM *block)
 	}
 }
 
-static void idct_put(uint8_t *dest, int line_size, DCTELEM *block)
+// the IDCT of a block with only the DC coefficient set is flat
+#define IDCT_DC(block) ((DCTELEM) (((block)[0] + 0x7F) >> 8))
+
+static void idct_put(uint8_t *dest, int line_size, DCTELEM *block, int coef_count)
 {
+	if (!coef_count) {
+		uint8_t v = IDCT_DC(block);
+		for (int i = 0; i < 8; i++) {
+			memset(dest + i*line_size, v, 8);
+		}
+		return;
+	}
 	bink_idct(block);
 	put_pixels_nonclamped(block, dest, line_size);
 }
 
-static void idct_add(uint8_t *dest, int line_size, DCTELEM *block)
+static void idct_add(uint8_t *dest, int line_size, DCTELEM *block, int coef_count)
 {
+	if (!coef_count) {
+		uint8_t v = IDCT_DC(block);
+		for (int i = 0; i < 8; i++) {
+			for (int j = 0; j < 8; j++) {
+				dest[j] += v;
+			}
+			dest += line_size;
+		}
+		return;
+	}
 	bink_idct(block);
 	add_pixels_nonclamped(block, dest, line_size);
 }
@@ -1570,8 +1674,8 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 				case INTRA_BLOCK:
 					clear_block(block);
 					block[0] = get_value(BINK_SRC_INTRA_DC);
-					read_dct_coeffs(block, c_scantable.permutated,true);
-					idct_put(dst, stride, block);
+					v = read_dct_coeffs(block, c_scantable.permutated,true);
+					idct_put(dst, stride, block, v);
 					break;
 				case FILL_BLOCK:
 					v = get_value(BINK_SRC_COLORS);
@@ -1585,8 +1689,8 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 					copy_block(block, prev + xoff + yoff*stride, dst, stride);
 					clear_block(block);
 					block[0] = get_value(BINK_SRC_INTER_DC);
-					read_dct_coeffs(block, c_scantable.permutated,false);
-					idct_add(dst, stride, block);
+					v = read_dct_coeffs(block, c_scantable.permutated,false);
+					idct_add(dst, stride, block, v);
 					break;
 				case PATTERN_BLOCK:
 					c1 = get_value(BINK_SRC_COLORS);
@@ -1613,7 +1717,9 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 		v_gb.get_bits_align32();
 	}
 
-	if (video_frameskip) {
+	if (benchmark) {
+		// decoding only, nothing to present
+	} else if (video_frameskip) {
 		video_frameskip--;
 		video_skippedframes++;
 	} else {
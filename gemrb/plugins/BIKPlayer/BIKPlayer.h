@@ -201,6 +201,7 @@ private:
 	bool done;
 	int outputwidth, outputheight;
 	unsigned int video_skippedframes;
+	bool benchmark; // decode as fast as possible, without presenting anything
 	//bink specific
 	ScanTable c_scantable;
 	Bundle c_bundle[BINK_NB_SRC];  ///< bundles for decoding all data types
@@ -219,6 +220,7 @@ private:
 	void segment_video_play();
 	bool next_frame();
 	int doPlay();
+	int doBenchmark();
 	unsigned int fileRead(unsigned int pos, void* buf, unsigned int count);
 	void showFrame(unsigned char** buf, unsigned int *strides, unsigned int bufw,
 		unsigned int bufh, unsigned int w, unsigned int h, unsigned int dstx,
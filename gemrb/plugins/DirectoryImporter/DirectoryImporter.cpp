@@ -25,6 +25,8 @@
 #include "ResourceDesc.h"
 #include "System/FileStream.h"
 
+#include <vector>
+
 using namespace GemRB;
 
 DirectoryImporter::DirectoryImporter(void)
@@ -124,29 +126,28 @@ void CachedDirectoryImporter::Refresh()
 	if (!it)
 		return;
 
-	unsigned int count = 0;
+	// read the directory only once, override folders of big mods hold
+	// tens of thousands of files
+	std::vector<std::string> names;
 	do {
 		if (it.IsDirectory())
 			continue;
-		count++;
+		names.push_back(it.GetName());
 	} while (++it);
 
+	unsigned int count = names.size();
 	// limit to 4k buckets
 	// less than 1% of the bg2+fixpack override are of bucket length >4
 	cache.init(count > 4 * 1024 ? 4 * 1024 : count, count);
 
-	it.Rewind();
-
 	char buf[_MAX_PATH];
-	do {
-		if (it.IsDirectory())
-			continue;
-		const char *name = it.GetName();
+	for (unsigned int i = 0; i < count; i++) {
+		const char *name = names[i].c_str();
 		strnlwrcpy(buf, name, _MAX_PATH, false);
 		if (cache.set(buf, name)) {
 			Log(ERROR, "CachedDirectoryImporter", "Duplicate '%s' files in '%s' directory", buf, path);
 		}
-	} while (++it);
+	}
 }
 
 static const char *ConstructFilename(const char* resname, const char* ext)
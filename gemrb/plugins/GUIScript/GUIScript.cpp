@@ -8203,6 +8203,48 @@ static PyObject* GemRB_GetPlayerStat(PyObject * /*self*/, PyObject* args)
 	}
 }
 
+PyDoc_STRVAR( GemRB_GetPlayerStats__doc,
+"===== GetPlayerStats =====\n\
+\n\
+**Prototype:** GemRB.GetPlayerStats(globalID[, Base])\n\
+\n\
+**Description:** Queries all the stats of the player character at once. \n\
+Useful when refreshing whole windows, since it is cheaper than calling \n\
+GetPlayerStat for each stat separately.\n\
+\n\
+**Parameters:**\n\
+  * globalID - party ID or global ID of the actor to use\n\
+  * Base - if set to 1, the function will return the base instead of the modified (current) values\n\
+\n\
+**Return value:** tuple, indexed by the stat index; the elements are the \n\
+same as what GetPlayerStat would return\n\
+\n\
+**See also:** [[guiscript:GetPlayerStat]]"
+);
+
+static PyObject* GemRB_GetPlayerStats(PyObject * /*self*/, PyObject* args)
+{
+	int globalID, BaseStat;
+
+	BaseStat = 0;
+	if (!PyArg_ParseTuple( args, "i|i", &globalID, &BaseStat )) {
+		return AttributeError( GemRB_GetPlayerStats__doc );
+	}
+	GET_GAME();
+	GET_ACTOR_GLOBAL();
+
+	PyObject* tuple = PyTuple_New( MAX_STATS );
+	for (int i = 0; i < MAX_STATS; i++) {
+		int StatValue = GetCreatureStat( actor, i, !BaseStat );
+		if ((unsigned)StatValue == 0xdadadada) {
+			PyTuple_SetItem( tuple, i, PyString_FromString("?") );
+		} else {
+			PyTuple_SetItem( tuple, i, PyInt_FromLong(StatValue) );
+		}
+	}
+	return tuple;
+}
+
 PyDoc_STRVAR( GemRB_SetPlayerStat__doc,
 "===== SetPlayerStat =====\n\
 \n\
@@ -10432,6 +10474,72 @@ static PyObject* GemRB_GetMemorizedSpell(PyObject * /*self*/, PyObject* args)
 	return dict;
 }
 
+PyDoc_STRVAR( GemRB_GetSpellbook__doc,
+"===== GetSpellbook =====\n\
+\n\
+**Prototype:** GemRB.GetSpellbook (globalID, SpellType)\n\
+\n\
+**Description:** Returns the known and memorized spells of the given type \n\
+from the PC's spellbook, for all levels at once.\n\
+\n\
+**Parameters:**\n\
+  * globalID  - party ID or global ID of the actor to use\n\
+  * SpellType - 0 - priest, 1 - wizard, 2 - innate\n\
+\n\
+**Return value:** tuple, indexed by spell level, of dictionaries (empty for \n\
+spell types the game doesn't have)\n\
+  * 'Known'     - tuple of the known spells' resrefs\n\
+  * 'Memorized' - tuple of dictionaries, the same as GetMemorizedSpell returns\n\
+\n\
+**See also:** [[guiscript:GetKnownSpell]], [[guiscript:GetMemorizedSpell]]\n\
+"
+);
+
+static PyObject* GemRB_GetSpellbook(PyObject * /*self*/, PyObject* args)
+{
+	int globalID, SpellType;
+
+	if (!PyArg_ParseTuple( args, "ii", &globalID, &SpellType)) {
+		return AttributeError( GemRB_GetSpellbook__doc );
+	}
+	GET_GAME();
+	GET_ACTOR_GLOBAL();
+
+	//like the count getters, an unknown type is just an empty book
+	if (SpellType < 0 || SpellType >= actor->spellbook.GetTypes()) {
+		return PyTuple_New( 0 );
+	}
+
+	unsigned int levels = actor->spellbook.GetSpellLevelCount( SpellType );
+	PyObject* book = PyTuple_New( levels );
+	for (unsigned int Level = 0; Level < levels; Level++) {
+		unsigned int count = actor->spellbook.GetKnownSpellsCount( SpellType, Level );
+		PyObject* known = PyTuple_New( count );
+		for (unsigned int i = 0; i < count; i++) {
+			CREKnownSpell* ks = actor->spellbook.GetKnownSpell( SpellType, Level, i );
+			PyTuple_SetItem( known, i, PyString_FromResRef (ks->SpellResRef) );
+		}
+
+		count = actor->spellbook.GetMemorizedSpellsCount( SpellType, Level, false );
+		PyObject* memorized = PyTuple_New( count );
+		for (unsigned int i = 0; i < count; i++) {
+			CREMemorizedSpell* ms = actor->spellbook.GetMemorizedSpell( SpellType, Level, i );
+			PyObject* spell = PyDict_New();
+			PyDict_SetItemString(spell, "SpellResRef", PyString_FromResRef (ms->SpellResRef));
+			PyDict_SetItemString(spell, "Flags", PyInt_FromLong (ms->Flags));
+			PyTuple_SetItem( memorized, i, spell );
+		}
+
+		PyObject* dict = PyDict_New();
+		PyDict_SetItemString(dict, "Known", known);
+		PyDict_SetItemString(dict, "Memorized", memorized);
+		Py_DECREF(known);
+		Py_DECREF(memorized);
+		PyTuple_SetItem( book, Level, dict );
+	}
+	return book;
+}
+
 
 PyDoc_STRVAR( GemRB_GetSpell__doc,
 "===== GetSpell =====\n\
@@ -10943,6 +11051,18 @@ the slot will not be looked up again.\n\
 **See also:** [[guiscript:GetItem]], [[guiscript:Button_SetItemIcon]], [[guiscript:ChangeItemFlag]]"
 );
 
+static PyObject* SlotItemDict(CREItem *si, int header)
+{
+	PyObject* dict = PyDict_New();
+	PyDict_SetItemString(dict, "ItemResRef", PyString_FromResRef (si->ItemResRef));
+	PyDict_SetItemString(dict, "Usages0", PyInt_FromLong (si->Usages[0]));
+	PyDict_SetItemString(dict, "Usages1", PyInt_FromLong (si->Usages[1]));
+	PyDict_SetItemString(dict, "Usages2", PyInt_FromLong (si->Usages[2]));
+	PyDict_SetItemString(dict, "Flags", PyInt_FromLong (si->Flags));
+	PyDict_SetItemString(dict, "Header", PyInt_FromLong (header));
+	return dict;
+}
+
 static PyObject* GemRB_GetSlotItem(PyObject * /*self*/, PyObject* args)
 {
 	int globalID, Slot;
@@ -10971,15 +11091,51 @@ static PyObject* GemRB_GetSlotItem(PyObject * /*self*/, PyObject* args)
 		Py_INCREF( Py_None );
 		return Py_None;
 	}
-	PyObject* dict = PyDict_New();
-	PyDict_SetItemString(dict, "ItemResRef", PyString_FromResRef (si->ItemResRef));
-	PyDict_SetItemString(dict, "Usages0", PyInt_FromLong (si->Usages[0]));
-	PyDict_SetItemString(dict, "Usages1", PyInt_FromLong (si->Usages[1]));
-	PyDict_SetItemString(dict, "Usages2", PyInt_FromLong (si->Usages[2]));
-	PyDict_SetItemString(dict, "Flags", PyInt_FromLong (si->Flags));
-	PyDict_SetItemString(dict, "Header", PyInt_FromLong (header));
+	return SlotItemDict(si, header);
+}
 
-	return dict;
+PyDoc_STRVAR( GemRB_GetSlotItems__doc,
+"===== GetSlotItems =====\n\
+\n\
+**Prototype:** GemRB.GetSlotItems (globalID)\n\
+\n\
+**Description:** Returns the data of all the occupied inventory slots of \n\
+the actor at once, so inventory windows don't have to query slot by slot.\n\
+\n\
+**Parameters:**\n\
+  * globalID - party ID or global ID of the actor to use\n\
+\n\
+**Return value:** dictionary, keyed by the (untranslated) slot number; the \n\
+values are the same dictionaries as GetSlotItem returns\n\
+\n\
+**See also:** [[guiscript:GetSlotItem]], [[guiscript:GetSlots]]"
+);
+
+static PyObject* GemRB_GetSlotItems(PyObject * /*self*/, PyObject* args)
+{
+	int globalID;
+
+	if (!PyArg_ParseTuple( args, "i", &globalID)) {
+		return AttributeError( GemRB_GetSlotItems__doc );
+	}
+	GET_GAME();
+	GET_ACTOR_GLOBAL();
+
+	PyObject* items = PyDict_New();
+	for (int i = 0; i < (int) core->SlotTypes; i++) {
+		int Slot = core->QuerySlot(i);
+		CREItem *si = actor->inventory.GetSlotItem( Slot );
+		if (!si) {
+			continue;
+		}
+		PyObject* key = PyInt_FromLong(i);
+		int header = actor->PCStats ? actor->PCStats->GetHeaderForSlot(Slot) : -1;
+		PyObject* dict = SlotItemDict(si, header);
+		PyDict_SetItem(items, key, dict);
+		Py_DECREF(key);
+		Py_DECREF(dict);
+	}
+	return items;
 }
 
 PyDoc_STRVAR( GemRB_ChangeItemFlag__doc,
@@ -12703,7 +12859,7 @@ static PyObject* GemRB_LeaveParty(PyObject * /*self*/, PyObject* args)
 		GameScript::SetLeavePartyDialogFile(actor, NULL);
 		if(actor->GetBase(IE_HITPOINTS) > 0) {
 			actor->Stop();
-			actor->AddAction( GenerateAction("Dialogue([PC])") );
+			actor->AddAction( GenerateCachedAction("Dialogue([PC])") );
 		}
 	}
 	game->LeaveParty (actor);
@@ -15614,6 +15770,7 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetPlayerName, METH_VARARGS),
 	METHOD(GetPlayerPortrait, METH_VARARGS),
 	METHOD(GetPlayerStat, METH_VARARGS),
+	METHOD(GetPlayerStats, METH_VARARGS),
 	METHOD(GetPlayerStates, METH_VARARGS),
 	METHOD(GetPlayerScript, METH_VARARGS),
 	METHOD(GetPlayerSound, METH_VARARGS),
@@ -15633,7 +15790,9 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetSpell, METH_VARARGS),
 	METHOD(GetSpelldata, METH_VARARGS),
 	METHOD(GetSpelldataIndex, METH_VARARGS),
+	METHOD(GetSpellbook, METH_VARARGS),
 	METHOD(GetSlotItem, METH_VARARGS),
+	METHOD(GetSlotItems, METH_VARARGS),
 	METHOD(GetSlots, METH_VARARGS),
 	METHOD(GetSystemVariable, METH_VARARGS),
 	METHOD(GetToken, METH_VARARGS),
@@ -15839,6 +15998,12 @@ GUIScript::GUIScript(void)
 GUIScript::~GUIScript(void)
 {
 	if (Py_IsInitialized()) {
+		std::map<std::string, FunctionHandle>::iterator it = functionCache.begin();
+		for (; it != functionCache.end(); ++it) {
+			Py_DECREF(it->second.module);
+			Py_DECREF(it->second.name);
+		}
+		functionCache.clear();
 		if (pModule) {
 			Py_DECREF( pModule );
 		}
@@ -16097,42 +16262,64 @@ bool GUIScript::LoadScript(const char* filename)
 	return true;
 }
 
-/* Similar to RunFunction, but with parameters, and doesn't necessarily fail */
-PyObject *GUIScript::RunFunction(const char* moduleName, const char* functionName, PyObject* pArgs, bool report_error)
+PyObject *GUIScript::GetFunction(const char* moduleName, const char* functionName, bool report_error)
 {
 	if (!Py_IsInitialized()) {
 		return NULL;
 	}
 
-	PyObject *module;
+	PyObject *pFunc;
 	if (moduleName) {
-		module = PyImport_ImportModule(const_cast<char*>(moduleName));
+		// named modules are imported once and kept, but the function itself is
+		// still looked up (with a prehashed name), so rebinding it in python works
+		std::string key = std::string(moduleName) + "." + functionName;
+		std::map<std::string, FunctionHandle>::iterator it = functionCache.find(key);
+		if (it == functionCache.end()) {
+			PyObject *module = PyImport_ImportModule(const_cast<char*>(moduleName));
+			if (module == NULL) {
+				PyErr_Print();
+				return NULL;
+			}
+			FunctionHandle handle;
+			handle.module = module;
+			handle.name = PyString_InternFromString(const_cast<char*>(functionName));
+			it = functionCache.insert(std::make_pair(key, handle)).first;
+		}
+		pFunc = PyDict_GetItem(PyModule_GetDict(it->second.module), it->second.name);
 	} else {
-		module = pModule;
-		Py_XINCREF(module);
-	}
-	if (module == NULL) {
-		PyErr_Print();
-		return NULL;
+		// the current window script changes with every LoadScript, so it isn't cached
+		if (pModule == NULL) {
+			PyErr_Print();
+			return NULL;
+		}
+		pFunc = PyDict_GetItemString(PyModule_GetDict(pModule), const_cast<char*>(functionName));
 	}
-	PyObject *dict = PyModule_GetDict(module);
-
-	PyObject *pFunc = PyDict_GetItemString(dict, const_cast<char*>(functionName));
 	/* pFunc: Borrowed reference */
 	if (!pFunc || !PyCallable_Check(pFunc)) {
 		if (report_error) {
 			Log(ERROR, "GUIScript", "Missing function: %s from %s", functionName, moduleName);
 		}
-		Py_DECREF(module);
 		return NULL;
 	}
+	return pFunc;
+}
+
+/* Similar to RunFunction, but with parameters, and doesn't necessarily fail */
+PyObject *GUIScript::RunFunction(const char* moduleName, const char* functionName, PyObject* pArgs, bool report_error)
+{
+	PyObject *pFunc = GetFunction(moduleName, functionName, report_error);
+	if (pFunc == NULL) {
+		return NULL;
+	}
+	// hold on to it, the call could rebind the name
+	Py_INCREF(pFunc);
 	PyObject *pValue = PyObject_CallObject( pFunc, pArgs );
 	if (pValue == NULL) {
 		if (PyErr_Occurred()) {
 			PyErr_Print();
 		}
 	}
-	Py_DECREF(module);
+	Py_DECREF(pFunc);
 	return pValue;
 }
 
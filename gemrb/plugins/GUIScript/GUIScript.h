@@ -33,6 +33,9 @@
 
 #include "ScriptEngine.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
 #define SV_BPP 0
@@ -46,6 +49,14 @@ public:
 	PyObject* pModule, * pDict;
 	PyObject* pMainDic;
 	PyObject* pGUIClasses;
+private:
+	/** a resolved (module, function) pair: the imported module and the interned function name */
+	struct FunctionHandle {
+		PyObject* module;
+		PyObject* name;
+	};
+	/** keyed by "module.function" */
+	std::map<std::string, FunctionHandle> functionCache;
 public:
 	GUIScript(void);
 	~GUIScript(void);
@@ -64,6 +75,8 @@ public:
 	void ExecString(const char* string, bool feedback=false);
 	/** lets hope this one can be here without screwing up the general interface */
 	PyObject *RunFunction(const char* moduleName, const char* fname, PyObject* pArgs, bool report_error = true);
+	/** Returns the callable (a borrowed reference), importing the module only the first time */
+	PyObject *GetFunction(const char* moduleName, const char* fname, bool report_error = true);
 	PyObject* ConstructObject(const char* classname, int arg);
 	PyObject* ConstructObject(const char* classname, PyObject* pArgs);
 };
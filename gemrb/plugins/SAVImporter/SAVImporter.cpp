@@ -24,6 +24,9 @@
 #include "FileCache.h"
 #include "Interface.h"
 #include "PluginMgr.h"
+#include "ResourceDesc.h"
+#include "System/FileStream.h"
+#include "System/MemoryStream.h"
 
 using namespace GemRB;
 
@@ -58,12 +61,26 @@ int SAVImporter::DecompressSaveGame(DataStream *compressed)
 		strlwr(fname);
 		compressed->ReadDword( &declen );
 		compressed->ReadDword( &complen );
-		print("Decompressing %s", fname);
-		DataStream* cached = CacheCompressedStream(compressed, fname, complen, true);
-		free( fname );
-		if (!cached)
-			return GEM_ERROR;
-		delete cached;
+		//areas are the bulk of a save, but most of them are only needed
+		//once visited, so they stay compressed until then
+		const char *ext = strrchr(fname, '.');
+		if (ext && !strcmp(ext, ".are")) {
+			void *data = malloc(complen);
+			if (compressed->Read(data, complen) != (int) complen) {
+				free( data );
+				free( fname );
+				return GEM_ERROR;
+			}
+			AddPendingCacheFile(fname, data, complen);
+			free( fname );
+		} else {
+			print("Decompressing %s", fname);
+			DataStream* cached = CacheCompressedStream(compressed, fname, complen, true);
+			free( fname );
+			if (!cached)
+				return GEM_ERROR;
+			delete cached;
+		}
 		Current = compressed->Remains();
 		//starting at 20% going up to 70%
 		percent = (20 + (All - Current) * 50 / All);
@@ -117,8 +134,112 @@ int SAVImporter::AddToSaveGame(DataStream *str, DataStream *uncompressed)
 	return GEM_OK;
 }
 
+//inflates every member of a written .sav again and compares the result
+//with the cached file it was made from
+int SAVImporter::VerifySaveGame(DataStream *compressed)
+{
+	char Signature[8];
+	if (compressed->Read( Signature, 8 ) != 8 || strncmp( Signature, "SAV V1.0", 8 ) ) {
+		return GEM_ERROR;
+	}
+	PluginHolder<Compressor> comp(PLUGIN_COMPRESSION_ZLIB);
+	int ret = GEM_OK;
+	while (compressed->Remains()) {
+		ieDword fnlen, complen, declen;
+		char fname[_MAX_PATH];
+		compressed->ReadDword( &fnlen );
+		if (!fnlen || fnlen > _MAX_PATH || compressed->Read( fname, fnlen ) != (int) fnlen) {
+			Log(ERROR, "SAVImporter", "Corrupt Save Detected");
+			return GEM_ERROR;
+		}
+		fname[fnlen-1] = 0;
+		compressed->ReadDword( &declen );
+		compressed->ReadDword( &complen );
+		void *packed = malloc(complen);
+		if (compressed->Read( packed, complen ) != (int) complen) {
+			free( packed );
+			Log(ERROR, "SAVImporter", "Corrupt Save Detected");
+			return GEM_ERROR;
+		}
+		MemoryStream member(fname, packed, complen);
+		MemoryStream inflated(fname, malloc(declen), declen);
+
+		char path[_MAX_PATH];
+		PathJoin(path, core->CachePath, fname, NULL);
+		FileStream cached;
+		bool same = cached.Open(path) && cached.Size() == declen &&
+			comp->Decompress(&inflated, &member, complen) == GEM_OK &&
+			inflated.GetPos() == declen;
+		if (same) {
+			char *data = (char *) malloc(declen);
+			inflated.Seek(0, GEM_STREAM_START);
+			inflated.Read(data, declen);
+			char *disk = (char *) malloc(declen);
+			same = cached.Read(disk, declen) == (int) declen && !memcmp(data, disk, declen);
+			free(data);
+			free(disk);
+		}
+		if (!same) {
+			Log(ERROR, "SAVImporter", "Saved member %s doesn't match the cache.", fname);
+			ret = GEM_ERROR;
+		}
+	}
+	return ret;
+}
+
+SAVSource::SAVSource(void)
+{
+	description = NULL;
+}
+
+SAVSource::~SAVSource(void)
+{
+	free(description);
+}
+
+bool SAVSource::Open(const char * /*filename*/, const char *desc)
+{
+	free(description);
+	description = strdup(desc);
+	return true;
+}
+
+static void MemberName(char *name, const char* resname, const char *ext)
+{
+	snprintf(name, _MAX_PATH, "%.8s.%s", resname, ext);
+}
+
+bool SAVSource::HasResource(const char* resname, SClass_ID type)
+{
+	char name[_MAX_PATH];
+	MemberName(name, resname, core->TypeExt(type));
+	return HasPendingCacheFile(name);
+}
+
+bool SAVSource::HasResource(const char* resname, const ResourceDesc &type)
+{
+	char name[_MAX_PATH];
+	MemberName(name, resname, type.GetExt());
+	return HasPendingCacheFile(name);
+}
+
+DataStream* SAVSource::GetResource(const char* resname, SClass_ID type)
+{
+	char name[_MAX_PATH];
+	MemberName(name, resname, core->TypeExt(type));
+	return ExtractPendingCacheFile(name);
+}
+
+DataStream* SAVSource::GetResource(const char* resname, const ResourceDesc &type)
+{
+	char name[_MAX_PATH];
+	MemberName(name, resname, type.GetExt());
+	return ExtractPendingCacheFile(name);
+}
+
 #include "plugindef.h"
 
 GEMRB_PLUGIN(0xCDF132C, "SAV File Importer")
 PLUGIN_CLASS(IE_SAV_CLASS_ID, SAVImporter)
+PLUGIN_CLASS(PLUGIN_RESOURCE_SAVEGAME, SAVSource)
 END_PLUGIN()
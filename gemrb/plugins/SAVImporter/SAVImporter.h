@@ -22,6 +22,7 @@
 #define SAVIMPORTER_H
 
 #include "ArchiveImporter.h"
+#include "ResourceSource.h"
 
 #include "globals.h"
 
@@ -36,6 +37,20 @@ public:
 	int DecompressSaveGame(DataStream *compressed);
 	int AddToSaveGame(DataStream *str, DataStream *uncompressed);
 	int CreateArchive(DataStream *compressed);
+	int VerifySaveGame(DataStream *compressed);
+};
+
+/* serves the saved game members left compressed by DecompressSaveGame,
+   inflating them into the cache on first use */
+class SAVSource : public ResourceSource {
+public:
+	SAVSource(void);
+	~SAVSource(void);
+	bool Open(const char *filename, const char *description);
+	bool HasResource(const char* resname, SClass_ID type);
+	bool HasResource(const char* resname, const ResourceDesc &type);
+	DataStream* GetResource(const char* resname, SClass_ID type);
+	DataStream* GetResource(const char* resname, const ResourceDesc &type);
 };
 
 }
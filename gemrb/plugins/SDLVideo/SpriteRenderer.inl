@@ -20,6 +20,8 @@
 
 // For debugging:
 //#define HIGHLIGHTCOVER
+// compare every pretinted palette blit with the per pixel tinting
+//#define VERIFYPRETINT
 
 
 
@@ -773,7 +775,7 @@ static void BlitSpritePAL_dispatch2(bool COVER, bool XFLIP,
 // call the BlitSpritePAL_dispatch2 instantiation with the right pixelformat
 // TODO: Hardcoded/non-hardcoded pixelformat
 template<typename Shadow, typename Tinter, typename Blender>
-static void BlitSpritePAL_dispatch(bool COVER, bool XFLIP,
+static void BlitSpritePAL_dispatchFormat(bool COVER, bool XFLIP,
             SDL_Surface* target,
             const Uint8* srcdata, const Color* col,
             int tx, int ty,
@@ -798,6 +800,90 @@ static void BlitSpritePAL_dispatch(bool COVER, bool XFLIP,
 	}
 }
 
+// Tinting only depends on the palette entry and the blit flags, so for
+// larger blits it is cheaper to tint the 256 palette entries once and then
+// run the plain palette lookup for every pixel.
+// The result is the same as tinting each pixel: the tinted alpha is kept
+// in the palette and passed on by SRTinter_NoTint<true>.
+#define PRETINT_MIN_PIXELS 256
+
+template<typename Shadow, typename Tinter, typename Blender>
+static void BlitSpritePAL_dispatch(bool COVER, bool XFLIP,
+            SDL_Surface* target,
+            const Uint8* srcdata, const Color* col,
+            int tx, int ty,
+            int width, int height,
+            bool yflip,
+            const Region& clip,
+            int transindex,
+            const SpriteCover* cover,
+            const Sprite2D* spr, unsigned int flags,
+            const Shadow& shadow, const Tinter& tint, const Blender& blend)
+{
+	if (clip.w * clip.h < PRETINT_MIN_PIXELS) {
+		BlitSpritePAL_dispatchFormat(COVER, XFLIP, target, srcdata, col, tx, ty,
+		                             width, height, yflip, clip, transindex,
+		                             cover, spr, flags, shadow, tint, blend);
+		return;
+	}
+
+#ifdef VERIFYPRETINT
+	// blit with per pixel tinting first, keep that result and restore the
+	// original pixels for the pretinted blit
+	int rowsize = clip.w * target->format->BytesPerPixel;
+	Uint8* rows = (Uint8*)target->pixels + clip.y * target->pitch + clip.x * target->format->BytesPerPixel;
+	std::vector<Uint8> original(rowsize * clip.h), expected(rowsize * clip.h);
+	for (int y = 0; y < clip.h; y++) {
+		memcpy(&original[y * rowsize], rows + y * target->pitch, rowsize);
+	}
+	BlitSpritePAL_dispatchFormat(COVER, XFLIP, target, srcdata, col, tx, ty,
+	                             width, height, yflip, clip, transindex,
+	                             cover, spr, flags, shadow, tint, blend);
+	for (int y = 0; y < clip.h; y++) {
+		memcpy(&expected[y * rowsize], rows + y * target->pitch, rowsize);
+		memcpy(rows + y * target->pitch, &original[y * rowsize], rowsize);
+	}
+#endif
+
+	Color tinted[256];
+	for (int i = 0; i < 256; i++) {
+		tinted[i] = col[i];
+		tint(tinted[i].r, tinted[i].g, tinted[i].b, tinted[i].a, flags);
+	}
+	SRTinter_NoTint<true> notint;
+	BlitSpritePAL_dispatchFormat(COVER, XFLIP, target, srcdata, tinted, tx, ty,
+	                             width, height, yflip, clip, transindex,
+	                             cover, spr, flags, shadow, notint, blend);
+
+#ifdef VERIFYPRETINT
+	for (int y = 0; y < clip.h; y++) {
+		if (memcmp(&expected[y * rowsize], rows + y * target->pitch, rowsize)) {
+			Log(ERROR, "SpriteRenderer", "Pretinted blit differs from per pixel tinting in line %d (flags 0x%x)!", clip.y + y, flags);
+			break;
+		}
+	}
+#endif
+}
+
+// nothing to pretint
+template<typename Shadow, bool PALALPHA, typename Blender>
+static void BlitSpritePAL_dispatch(bool COVER, bool XFLIP,
+            SDL_Surface* target,
+            const Uint8* srcdata, const Color* col,
+            int tx, int ty,
+            int width, int height,
+            bool yflip,
+            const Region& clip,
+            int transindex,
+            const SpriteCover* cover,
+            const Sprite2D* spr, unsigned int flags,
+            const Shadow& shadow, const SRTinter_NoTint<PALALPHA>& tint, const Blender& blend)
+{
+	BlitSpritePAL_dispatchFormat(COVER, XFLIP, target, srcdata, col, tx, ty,
+	                             width, height, yflip, clip, transindex,
+	                             cover, spr, flags, shadow, tint, blend);
+}
+
 // call the BlitSpriteRGB_internal instantiation with the specified
 // COVER, XFLIP bools
 template<typename PTYPE, typename Tinter, typename Blender>